@@ -0,0 +1,317 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+// Bump-pointer arena - deallocation is a no-op, all memory is freed at once by release()
+class MonotonicArena
+{
+    struct Chunk
+    {
+        Chunk* next;
+        std::size_t size;
+    };
+
+    Chunk* chunks = nullptr;
+    std::byte* current = nullptr;
+    std::size_t remaining = 0;
+    std::size_t initial_chunk_size;
+    std::size_t next_chunk_size;
+
+    void add_chunk(std::size_t min_size)
+    {
+        const std::size_t size = std::max(next_chunk_size, min_size);
+
+        void* memory = ::operator new(sizeof(Chunk) + size);
+        chunks = ::new (memory) Chunk{chunks, size};
+        current = reinterpret_cast<std::byte*>(chunks + 1);
+        remaining = size;
+
+        next_chunk_size = 2 * size;
+    }
+
+public:
+    explicit MonotonicArena(std::size_t chunk_size = 4096)
+        : initial_chunk_size{chunk_size}
+        , next_chunk_size{chunk_size}
+    {
+    }
+
+    MonotonicArena(const MonotonicArena&) = delete;
+    MonotonicArena& operator=(const MonotonicArena&) = delete;
+
+    ~MonotonicArena()
+    {
+        release();
+    }
+
+    void* allocate(std::size_t bytes, std::size_t alignment = alignof(std::max_align_t))
+    {
+        void* ptr = current;
+        if (!std::align(alignment, bytes, ptr, remaining))
+        {
+            add_chunk(bytes + alignment);
+            ptr = current;
+            std::align(alignment, bytes, ptr, remaining);
+        }
+
+        current = static_cast<std::byte*>(ptr) + bytes;
+        remaining -= bytes;
+
+        return ptr;
+    }
+
+    // frees all chunks - every container using the arena must be already destroyed
+    void release() noexcept
+    {
+        while (chunks)
+        {
+            Chunk* next = chunks->next;
+            ::operator delete(chunks);
+            chunks = next;
+        }
+
+        current = nullptr;
+        remaining = 0;
+        next_chunk_size = initial_chunk_size;
+    }
+};
+
+inline MonotonicArena& thread_local_arena()
+{
+    thread_local MonotonicArena arena;
+    return arena;
+}
+
+template <typename T>
+class ArenaAllocator
+{
+    template <typename U>
+    friend class ArenaAllocator;
+
+    MonotonicArena* arena;
+
+public:
+    using value_type = T;
+
+    // default constructed allocator uses thread local arena
+    ArenaAllocator() noexcept
+        : arena{&thread_local_arena()}
+    {
+    }
+
+    explicit ArenaAllocator(MonotonicArena& resource) noexcept
+        : arena{&resource}
+    {
+    }
+
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) noexcept
+        : arena{other.arena}
+    {
+    }
+
+    T* allocate(std::size_t n)
+    {
+        if (n > std::size_t(-1) / sizeof(T))
+            throw std::bad_array_new_length();
+
+        return static_cast<T*>(arena->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T*, std::size_t) noexcept
+    {
+    }
+
+    MonotonicArena* resource() const noexcept
+    {
+        return arena;
+    }
+
+    template <typename U>
+    bool operator==(const ArenaAllocator<U>& other) const noexcept
+    {
+        return arena == other.arena;
+    }
+};
+
+// Free list of equally sized blocks carved out of larger chunks
+class FixedBlockPool
+{
+    struct FreeBlock
+    {
+        FreeBlock* next;
+    };
+
+    std::size_t block_size;
+    std::size_t blocks_per_chunk;
+    FreeBlock* free_list = nullptr;
+    std::vector<void*> chunks;
+
+    void add_chunk()
+    {
+        chunks.reserve(chunks.size() + 1);
+        std::byte* chunk = static_cast<std::byte*>(::operator new(block_size * blocks_per_chunk));
+        chunks.push_back(chunk);
+
+        for (std::size_t i = blocks_per_chunk; i > 0; --i)
+            free_list = ::new (chunk + (i - 1) * block_size) FreeBlock{free_list};
+
+        blocks_per_chunk *= 2;
+    }
+
+public:
+    explicit FixedBlockPool(std::size_t block_size, std::size_t blocks_per_chunk = 32)
+        : block_size{std::max(block_size, sizeof(FreeBlock))}
+        , blocks_per_chunk{blocks_per_chunk}
+    {
+    }
+
+    FixedBlockPool(const FixedBlockPool&) = delete;
+    FixedBlockPool& operator=(const FixedBlockPool&) = delete;
+
+    FixedBlockPool(FixedBlockPool&& other) noexcept
+        : block_size{other.block_size}
+        , blocks_per_chunk{other.blocks_per_chunk}
+        , free_list{std::exchange(other.free_list, nullptr)}
+        , chunks{std::move(other.chunks)}
+    {
+    }
+
+    ~FixedBlockPool()
+    {
+        release();
+    }
+
+    std::size_t size_of_block() const noexcept
+    {
+        return block_size;
+    }
+
+    void* allocate()
+    {
+        if (!free_list)
+            add_chunk();
+
+        return std::exchange(free_list, free_list->next);
+    }
+
+    void deallocate(void* block) noexcept
+    {
+        free_list = ::new (block) FreeBlock{free_list};
+    }
+
+    void release() noexcept
+    {
+        for (void* chunk : chunks)
+            ::operator delete(chunk);
+
+        chunks.clear();
+        free_list = nullptr;
+    }
+};
+
+// Set of pools with size classes in steps of granularity - requests above max_block_size go to operator new
+class BlockPools
+{
+    std::vector<FixedBlockPool> pools;
+
+    // zero-size requests use the smallest size class
+    static std::size_t pool_index(std::size_t bytes) noexcept
+    {
+        return (std::max<std::size_t>(bytes, 1) + granularity - 1) / granularity - 1;
+    }
+
+public:
+    static constexpr std::size_t granularity = alignof(std::max_align_t);
+    static constexpr std::size_t max_block_size = 1024;
+
+    BlockPools()
+    {
+        pools.reserve(max_block_size / granularity);
+        for (std::size_t size = granularity; size <= max_block_size; size += granularity)
+            pools.emplace_back(size);
+    }
+
+    void* allocate(std::size_t bytes)
+    {
+        if (bytes > max_block_size)
+            return ::operator new(bytes);
+
+        return pools[pool_index(bytes)].allocate();
+    }
+
+    void deallocate(void* ptr, std::size_t bytes) noexcept
+    {
+        if (bytes > max_block_size)
+            ::operator delete(ptr);
+        else
+            pools[pool_index(bytes)].deallocate(ptr);
+    }
+
+    void release() noexcept
+    {
+        for (auto& pool : pools)
+            pool.release();
+    }
+};
+
+inline BlockPools& thread_local_pools()
+{
+    thread_local BlockPools pools;
+    return pools;
+}
+
+template <typename T>
+class PoolAllocator
+{
+    static_assert(alignof(T) <= BlockPools::granularity, "Over-aligned types are not supported");
+
+    template <typename U>
+    friend class PoolAllocator;
+
+    BlockPools* pools;
+
+public:
+    using value_type = T;
+
+    // default constructed allocator uses thread local pools - memory must be deallocated by the same thread
+    PoolAllocator() noexcept
+        : pools{&thread_local_pools()}
+    {
+    }
+
+    explicit PoolAllocator(BlockPools& resource) noexcept
+        : pools{&resource}
+    {
+    }
+
+    template <typename U>
+    PoolAllocator(const PoolAllocator<U>& other) noexcept
+        : pools{other.pools}
+    {
+    }
+
+    T* allocate(std::size_t n)
+    {
+        if (n > std::size_t(-1) / sizeof(T))
+            throw std::bad_array_new_length();
+
+        return static_cast<T*>(pools->allocate(n * sizeof(T)));
+    }
+
+    void deallocate(T* ptr, std::size_t n) noexcept
+    {
+        pools->deallocate(ptr, n * sizeof(T));
+    }
+
+    template <typename U>
+    bool operator==(const PoolAllocator<U>& other) const noexcept
+    {
+        return pools == other.pools;
+    }
+};
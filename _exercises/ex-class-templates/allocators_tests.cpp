@@ -0,0 +1,285 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <deque>
+#include <list>
+#include <memory_resource>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "allocators.hpp"
+#include "stack.hpp"
+
+TEST_CASE("MonotonicArena", "[allocators]")
+{
+    MonotonicArena arena{64};
+
+    SECTION("allocations are aligned")
+    {
+        void* p1 = arena.allocate(1, 1);
+        void* p2 = arena.allocate(sizeof(double), alignof(double));
+
+        REQUIRE(p1 != p2);
+        REQUIRE(reinterpret_cast<std::uintptr_t>(p2) % alignof(double) == 0);
+    }
+
+    SECTION("allocation larger than chunk size")
+    {
+        void* ptr = arena.allocate(1024);
+
+        REQUIRE(ptr != nullptr);
+    }
+}
+
+// moves with the container & has no default constructor - a container using it is never silently switched to the thread local arena
+template <typename T>
+struct PropagatingArenaAllocator : ArenaAllocator<T>
+{
+    using propagate_on_container_move_assignment = std::true_type;
+
+    explicit PropagatingArenaAllocator(MonotonicArena& resource) noexcept
+        : ArenaAllocator<T>{resource}
+    {
+    }
+
+    template <typename U>
+    PropagatingArenaAllocator(const PropagatingArenaAllocator<U>& other) noexcept
+        : ArenaAllocator<T>{other}
+    {
+    }
+};
+
+TEST_CASE("ArenaAllocator", "[allocators]")
+{
+    MonotonicArena arena;
+
+    SECTION("std containers")
+    {
+        std::vector<int, ArenaAllocator<int>> vec{ArenaAllocator<int>{arena}};
+        std::list<std::string, ArenaAllocator<std::string>> lst{ArenaAllocator<std::string>{arena}};
+
+        for (int i = 0; i < 100; ++i)
+        {
+            vec.push_back(i);
+            lst.push_back(std::to_string(i));
+        }
+
+        REQUIRE(vec.size() == 100);
+        REQUIRE(lst.back() == "99");
+        REQUIRE(lst.get_allocator().resource() == &arena);
+    }
+
+    SECTION("rebound allocators are equal")
+    {
+        ArenaAllocator<int> a1{arena};
+        ArenaAllocator<double> a2{a1};
+
+        REQUIRE(a1 == a2);
+        REQUIRE(a1 != ArenaAllocator<int>{});
+    }
+
+    SECTION("TemplateTemplateParam::Stack")
+    {
+        TemplateTemplateParam::Stack<int, std::deque, ArenaAllocator<int>> s{ArenaAllocator<int>{arena}};
+
+        for (int i = 0; i < 1000; ++i)
+            s.push(i);
+
+        REQUIRE(s.pop() == 999);
+    }
+
+    SECTION("TemplateTemplateParam::Stack - drain keeps the allocator")
+    {
+        using Allocator = PropagatingArenaAllocator<int>;
+        TemplateTemplateParam::Stack<int, std::deque, Allocator> s{Allocator{arena}};
+        s.push(1);
+
+        auto items = s.drain();
+        REQUIRE(items.get_allocator().resource() == &arena);
+
+        s.push(2); // allocates the new storage
+        auto items_pushed_after_drain = s.drain();
+
+        REQUIRE(items_pushed_after_drain.back() == 2);
+        REQUIRE(items_pushed_after_drain.get_allocator().resource() == &arena);
+    }
+
+    SECTION("default constructed allocator uses thread local arena")
+    {
+        {
+            TemplateTemplateParam::Stack<int, std::list, ArenaAllocator<int>> s;
+            s.push(42);
+
+            REQUIRE(s.top() == 42);
+        }
+
+        thread_local_arena().release();
+    }
+}
+
+TEST_CASE("PoolAllocator", "[allocators]")
+{
+    BlockPools pools;
+
+    SECTION("freed blocks are reused")
+    {
+        PoolAllocator<double> alloc{pools};
+
+        double* p1 = alloc.allocate(1);
+        alloc.deallocate(p1, 1);
+        double* p2 = alloc.allocate(1);
+
+        REQUIRE(p1 == p2);
+        alloc.deallocate(p2, 1);
+    }
+
+    SECTION("zero-size allocation")
+    {
+        PoolAllocator<double> alloc{pools};
+
+        double* p1 = alloc.allocate(0);
+        double* p2 = alloc.allocate(0);
+
+        REQUIRE(p1 != nullptr);
+        REQUIRE(p1 != p2);
+
+        alloc.deallocate(p1, 0);
+        alloc.deallocate(p2, 0);
+        REQUIRE(alloc.allocate(1) == p2); // the smallest size class
+    }
+
+    SECTION("TemplateTemplateParam::Stack")
+    {
+        TemplateTemplateParam::Stack<std::string, std::list, PoolAllocator<std::string>> s{PoolAllocator<std::string>{pools}};
+
+        s.push_range(std::vector<std::string>{"one", "two", "three"});
+
+        REQUIRE(s.pop() == "three");
+        REQUIRE(s.size() == 2);
+    }
+
+    SECTION("std::deque")
+    {
+        TemplateTemplateParam::Stack<int, std::deque, PoolAllocator<int>> s;
+
+        for (int i = 0; i < 1000; ++i)
+            s.push(i);
+
+        REQUIRE(s.size() == 1000);
+    }
+}
+
+namespace
+{
+    constexpr int items_per_request = 256;
+
+    template <typename TStack>
+    int process_request(TStack& s)
+    {
+        for (int i = 0; i < items_per_request; ++i)
+            s.push(i);
+
+        int sum = 0;
+        while (!s.empty())
+            sum += s.pop();
+
+        return sum;
+    }
+} // namespace
+
+TEST_CASE("Allocation latency", "[.][benchmark][allocators]")
+{
+    constexpr int count = 1'000;
+    std::vector<int*> ptrs(count);
+
+    auto allocate_all = [&ptrs](auto& alloc) {
+        for (auto& ptr : ptrs)
+            ptr = alloc.allocate(1);
+        for (auto& ptr : ptrs)
+            alloc.deallocate(ptr, 1);
+        return ptrs.back();
+    };
+
+    BENCHMARK("std::allocator")
+    {
+        std::allocator<int> alloc;
+        return allocate_all(alloc);
+    };
+
+    BENCHMARK("std::pmr::monotonic_buffer_resource")
+    {
+        std::pmr::monotonic_buffer_resource resource;
+        std::pmr::polymorphic_allocator<int> alloc{&resource};
+        return allocate_all(alloc);
+    };
+
+    BENCHMARK("ArenaAllocator")
+    {
+        MonotonicArena arena;
+        ArenaAllocator<int> alloc{arena};
+        return allocate_all(alloc);
+    };
+
+    BENCHMARK("PoolAllocator")
+    {
+        PoolAllocator<int> alloc;
+        return allocate_all(alloc);
+    };
+}
+
+TEST_CASE("Per-request stacks", "[.][benchmark][allocators]")
+{
+    BENCHMARK("std::list + std::allocator")
+    {
+        TemplateTemplateParam::Stack<int, std::list> s;
+        return process_request(s);
+    };
+
+    BENCHMARK("std::list + std::pmr::monotonic_buffer_resource")
+    {
+        std::pmr::monotonic_buffer_resource resource;
+        TemplateTemplateParam::Stack<int, std::list, std::pmr::polymorphic_allocator<int>> s{&resource};
+        return process_request(s);
+    };
+
+    BENCHMARK("std::list + ArenaAllocator")
+    {
+        int result;
+        {
+            TemplateTemplateParam::Stack<int, std::list, ArenaAllocator<int>> s;
+            result = process_request(s);
+        }
+        thread_local_arena().release();
+        return result;
+    };
+
+    BENCHMARK("std::list + PoolAllocator")
+    {
+        TemplateTemplateParam::Stack<int, std::list, PoolAllocator<int>> s;
+        return process_request(s);
+    };
+
+    BENCHMARK("std::deque + std::allocator")
+    {
+        TemplateTemplateParam::Stack<int, std::deque> s;
+        return process_request(s);
+    };
+
+    BENCHMARK("std::deque + ArenaAllocator")
+    {
+        int result;
+        {
+            TemplateTemplateParam::Stack<int, std::deque, ArenaAllocator<int>> s;
+            result = process_request(s);
+        }
+        thread_local_arena().release();
+        return result;
+    };
+
+    BENCHMARK("std::deque + PoolAllocator")
+    {
+        TemplateTemplateParam::Stack<int, std::deque, PoolAllocator<int>> s;
+        return process_request(s);
+    };
+}
@@ -0,0 +1,369 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace HazardPointers
+{
+    // one hazard pointer per thread is enough for a Treiber stack (pop & top protect only the head node)
+    inline constexpr std::size_t max_threads = 128;
+    inline constexpr std::size_t reclaim_threshold = 2 * max_threads;
+
+    struct alignas(64) Slot
+    {
+        std::atomic<bool> in_use{false};
+        std::atomic<void*> pointer{nullptr};
+    };
+
+    inline std::array<Slot, max_threads> slots{};
+
+    struct Retired
+    {
+        void* pointer;
+        void (*deleter)(void*);
+    };
+
+    // retired nodes left behind by threads that exited while the nodes were still protected
+    struct Orphans
+    {
+        std::mutex mtx;
+        std::vector<Retired> items;
+
+        ~Orphans()
+        {
+            for (const auto& item : items)
+                item.deleter(item.pointer);
+        }
+    };
+
+    inline Orphans orphans;
+
+    class SlotOwner
+    {
+        Slot* slot;
+
+    public:
+        SlotOwner()
+        {
+            for (auto& candidate : slots)
+            {
+                bool expected = false;
+                if (!candidate.in_use.load(std::memory_order_relaxed) && candidate.in_use.compare_exchange_strong(expected, true, std::memory_order_acquire))
+                {
+                    slot = &candidate;
+                    return;
+                }
+            }
+
+            throw std::runtime_error("Too many threads use hazard pointers");
+        }
+
+        SlotOwner(const SlotOwner&) = delete;
+        SlotOwner& operator=(const SlotOwner&) = delete;
+
+        ~SlotOwner()
+        {
+            slot->pointer.store(nullptr, std::memory_order_release);
+            slot->in_use.store(false, std::memory_order_release);
+        }
+
+        std::atomic<void*>& pointer()
+        {
+            return slot->pointer;
+        }
+    };
+
+    inline std::atomic<void*>& hazard_pointer()
+    {
+        thread_local SlotOwner owner;
+        return owner.pointer();
+    }
+
+    // publishes the current value of src as hazardous - returned pointer is safe to dereference until hazard is cleared
+    template <typename T>
+    T* protect(const std::atomic<T*>& src)
+    {
+        std::atomic<void*>& hazard = hazard_pointer();
+
+        T* ptr = src.load(std::memory_order_relaxed);
+        while (true)
+        {
+            hazard.store(ptr); // seq_cst: store must be visible before src is re-read
+            T* current = src.load();
+            if (current == ptr)
+                return ptr;
+            ptr = current;
+        }
+    }
+
+    inline void clear()
+    {
+        hazard_pointer().store(nullptr, std::memory_order_release);
+    }
+
+    class RetireList
+    {
+        std::vector<Retired> items;
+
+    public:
+        RetireList() = default;
+        RetireList(const RetireList&) = delete;
+        RetireList& operator=(const RetireList&) = delete;
+
+        ~RetireList()
+        {
+            reclaim();
+
+            if (!items.empty())
+            {
+                std::lock_guard lk{orphans.mtx};
+                orphans.items.insert(orphans.items.end(), items.begin(), items.end());
+            }
+        }
+
+        void retire(void* ptr, void (*deleter)(void*))
+        {
+            items.push_back(Retired{ptr, deleter});
+
+            if (items.size() >= reclaim_threshold)
+                reclaim();
+        }
+
+        void reclaim()
+        {
+            if (std::unique_lock lk{orphans.mtx, std::try_to_lock}; lk.owns_lock() && !orphans.items.empty())
+            {
+                items.insert(items.end(), orphans.items.begin(), orphans.items.end());
+                orphans.items.clear();
+            }
+
+            std::vector<void*> hazards;
+            hazards.reserve(max_threads);
+            for (const auto& slot : slots)
+            {
+                if (void* ptr = slot.pointer.load(); ptr != nullptr)
+                    hazards.push_back(ptr);
+            }
+            std::sort(hazards.begin(), hazards.end());
+
+            auto still_protected = std::partition(items.begin(), items.end(), [&hazards](const Retired& item) {
+                return !std::binary_search(hazards.begin(), hazards.end(), item.pointer);
+            });
+
+            for (auto it = items.begin(); it != still_protected; ++it)
+                it->deleter(it->pointer);
+
+            items.erase(items.begin(), still_protected);
+        }
+    };
+
+    template <typename T>
+    void retire(T* ptr)
+    {
+        thread_local RetireList retired;
+        retired.retire(ptr, [](void* p) { delete static_cast<T*>(p); });
+    }
+} // namespace HazardPointers
+
+// Backoff policies for ConcurrentStack
+
+struct NoBackoff
+{
+    bool try_push(void*)
+    {
+        return false;
+    }
+
+    void* try_pop()
+    {
+        return nullptr;
+    }
+};
+
+// Elimination array: a push and a pop that collide on the head may exchange the node directly
+template <std::size_t Width = 8, std::size_t Spins = 128>
+class EliminationBackoff
+{
+    struct alignas(64) Cell
+    {
+        std::atomic<void*> item{nullptr};
+    };
+
+    std::array<Cell, Width> cells;
+
+    static inline char taken_marker{};
+
+    static void* taken()
+    {
+        return &taken_marker;
+    }
+
+    Cell& random_cell()
+    {
+        thread_local std::minstd_rand engine{static_cast<std::uint_fast32_t>(std::hash<std::thread::id>{}(std::this_thread::get_id()))};
+        return cells[engine() % Width];
+    }
+
+public:
+    // offers a node to a concurrent pop; returns true if the node was taken
+    bool try_push(void* node)
+    {
+        Cell& cell = random_cell();
+
+        void* expected = nullptr;
+        if (!cell.item.compare_exchange_strong(expected, node, std::memory_order_release, std::memory_order_relaxed))
+            return false;
+
+        for (std::size_t i = 0; i < Spins; ++i)
+        {
+            if (cell.item.load(std::memory_order_acquire) != node) // only a pop can replace our node (with taken marker)
+            {
+                cell.item.store(nullptr, std::memory_order_release);
+                return true;
+            }
+        }
+
+        expected = node;
+        if (cell.item.compare_exchange_strong(expected, nullptr, std::memory_order_acq_rel))
+            return false; // withdrawn - nobody came
+
+        cell.item.store(nullptr, std::memory_order_release);
+        return true;
+    }
+
+    // takes a node offered by a concurrent push; the caller becomes its exclusive owner
+    void* try_pop()
+    {
+        Cell& cell = random_cell();
+
+        void* node = cell.item.load(std::memory_order_acquire);
+        if (node == nullptr || node == taken())
+            return nullptr;
+
+        if (cell.item.compare_exchange_strong(node, taken(), std::memory_order_acq_rel))
+            return node;
+
+        return nullptr;
+    }
+};
+
+// Lock-free Treiber stack with hazard pointer based memory reclamation
+template <typename TItem, typename TBackoff = NoBackoff>
+class ConcurrentStack
+{
+    struct Node
+    {
+        TItem value;
+        Node* next;
+    };
+
+    std::atomic<Node*> head{nullptr};
+    std::atomic<std::size_t> count{0};
+    TBackoff backoff{};
+
+public:
+    using value_type = TItem;
+
+    ConcurrentStack() = default;
+    ConcurrentStack(const ConcurrentStack&) = delete;
+    ConcurrentStack& operator=(const ConcurrentStack&) = delete;
+
+    ~ConcurrentStack()
+    {
+        Node* node = head.load(std::memory_order_relaxed);
+        while (node)
+            delete std::exchange(node, node->next);
+    }
+
+    // approximate when other threads are pushing or popping
+    std::size_t size() const
+    {
+        return count.load(std::memory_order_relaxed);
+    }
+
+    bool empty() const
+    {
+        return head.load(std::memory_order_acquire) == nullptr;
+    }
+
+    template <typename T>
+    void push(T&& _value)
+    {
+        Node* node = new Node{std::forward<T>(_value), head.load(std::memory_order_relaxed)};
+        count.fetch_add(1, std::memory_order_relaxed);
+
+        while (!head.compare_exchange_weak(node->next, node, std::memory_order_release, std::memory_order_relaxed))
+        {
+            if (backoff.try_push(node))
+                return;
+        }
+    }
+
+    // returns false if stack is empty
+    bool pop(value_type& _value)
+    {
+        Node* node = nullptr;
+
+        while (true)
+        {
+            node = HazardPointers::protect(head);
+
+            if (!node)
+            {
+                HazardPointers::clear();
+                return false;
+            }
+
+            if (head.compare_exchange_weak(node, node->next, std::memory_order_acquire, std::memory_order_relaxed))
+                break;
+
+            if (void* exchanged = backoff.try_pop())
+            {
+                HazardPointers::clear();
+                Node* eliminated = static_cast<Node*>(exchanged);
+                _value = std::move(eliminated->value);
+                delete eliminated;
+                count.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+
+        HazardPointers::clear();
+
+        // top() may still be copying the value of the unlinked node - move is safe only when top() is disabled
+        if constexpr (std::is_copy_constructible_v<value_type>)
+            _value = node->value;
+        else
+            _value = std::move(node->value);
+
+        HazardPointers::retire(node);
+        count.fetch_sub(1, std::memory_order_relaxed);
+
+        return true;
+    }
+
+    // returns a copy - a reference to the top could dangle as soon as another thread pops
+    std::optional<value_type> top() const
+        requires std::is_copy_constructible_v<value_type>
+    {
+        std::optional<value_type> result;
+
+        if (Node* node = HazardPointers::protect(head))
+            result.emplace(node->value);
+
+        HazardPointers::clear();
+
+        return result;
+    }
+};
@@ -0,0 +1,185 @@
+#include <algorithm>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "concurrent_stack.hpp"
+#include "stack.hpp"
+
+TEMPLATE_TEST_CASE("ConcurrentStack - single thread", "[concurrent_stack]", NoBackoff, EliminationBackoff<>)
+{
+    ConcurrentStack<std::string, TestType> s;
+
+    SECTION("after construction is empty")
+    {
+        REQUIRE(s.empty());
+        REQUIRE(s.size() == 0);
+        REQUIRE(!s.top().has_value());
+    }
+
+    SECTION("pushed item is on a top")
+    {
+        s.push("one");
+        s.push(std::string("two"));
+
+        REQUIRE(s.size() == 2);
+        REQUIRE(s.top() == "two");
+    }
+
+    SECTION("LIFO order")
+    {
+        s.push("one");
+        s.push("two");
+
+        std::string a, b;
+        REQUIRE(s.pop(a));
+        REQUIRE(s.pop(b));
+
+        REQUIRE(a == "two");
+        REQUIRE(b == "one");
+        REQUIRE(s.empty());
+    }
+
+    SECTION("pop from empty stack reports failure")
+    {
+        std::string item = "unchanged";
+
+        REQUIRE_FALSE(s.pop(item));
+        REQUIRE(item == "unchanged");
+    }
+}
+
+TEST_CASE("ConcurrentStack - move-only items", "[concurrent_stack]")
+{
+    ConcurrentStack<std::unique_ptr<int>> s;
+
+    s.push(std::make_unique<int>(42));
+
+    std::unique_ptr<int> ptr;
+    REQUIRE(s.pop(ptr));
+    REQUIRE(*ptr == 42);
+}
+
+TEMPLATE_TEST_CASE("ConcurrentStack - stress test", "[concurrent_stack][threads]", NoBackoff, EliminationBackoff<>)
+{
+    constexpr int producers = 4;
+    constexpr int consumers = 4;
+    constexpr int items_per_producer = 20'000;
+    constexpr int total = producers * items_per_producer;
+
+    ConcurrentStack<int, TestType> s;
+    std::atomic<int> popped_count{0};
+    std::vector<std::vector<int>> popped(consumers);
+
+    {
+        std::vector<std::jthread> threads;
+
+        for (int p = 0; p < producers; ++p)
+            threads.emplace_back([&s, p] {
+                for (int i = 0; i < items_per_producer; ++i)
+                    s.push(p * items_per_producer + i);
+            });
+
+        for (int c = 0; c < consumers; ++c)
+            threads.emplace_back([&, c] {
+                int item;
+                while (popped_count.load() < total)
+                {
+                    if (s.pop(item))
+                    {
+                        popped[c].push_back(item);
+                        ++popped_count;
+                    }
+                }
+            });
+    }
+
+    std::vector<int> all_items;
+    for (const auto& items : popped)
+        all_items.insert(all_items.end(), items.begin(), items.end());
+    std::sort(all_items.begin(), all_items.end());
+
+    std::vector<int> expected(total);
+    std::iota(expected.begin(), expected.end(), 0);
+
+    REQUIRE(all_items == expected);
+    REQUIRE(s.empty());
+    REQUIRE(s.size() == 0);
+}
+
+template <typename TItem>
+class LockedStack
+{
+    std::mutex mtx;
+    Stack<TItem> stack;
+
+public:
+    using value_type = TItem;
+
+    template <typename T>
+    void push(T&& _value)
+    {
+        std::lock_guard lk{mtx};
+        stack.push(std::forward<T>(_value));
+    }
+
+    bool pop(value_type& _value)
+    {
+        std::lock_guard lk{mtx};
+        if (stack.empty())
+            return false;
+        stack.pop(_value);
+        return true;
+    }
+};
+
+template <typename TStack>
+void push_pop_from_threads(TStack& s, unsigned thread_count, int operations_per_thread)
+{
+    std::vector<std::jthread> threads;
+
+    for (unsigned t = 0; t < thread_count; ++t)
+        threads.emplace_back([&s, operations_per_thread] {
+            int item;
+            for (int i = 0; i < operations_per_thread; ++i)
+            {
+                s.push(i);
+                s.pop(item);
+            }
+        });
+}
+
+TEST_CASE("ConcurrentStack - throughput", "[.][benchmark][concurrent_stack]")
+{
+    constexpr int operations_per_thread = 100'000;
+    const unsigned max_threads = std::max(1u, std::thread::hardware_concurrency());
+
+    for (unsigned thread_count = 1; thread_count <= max_threads; ++thread_count)
+    {
+        const std::string suffix = " - " + std::to_string(thread_count) + " threads";
+
+        BENCHMARK("LockedStack" + suffix)
+        {
+            LockedStack<int> s;
+            push_pop_from_threads(s, thread_count, operations_per_thread);
+        };
+
+        BENCHMARK("ConcurrentStack" + suffix)
+        {
+            ConcurrentStack<int> s;
+            push_pop_from_threads(s, thread_count, operations_per_thread);
+        };
+
+        BENCHMARK("ConcurrentStack with elimination" + suffix)
+        {
+            ConcurrentStack<int, EliminationBackoff<>> s;
+            push_pop_from_threads(s, thread_count, operations_per_thread);
+        };
+    }
+}
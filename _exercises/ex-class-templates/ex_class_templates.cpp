@@ -1,5 +1,6 @@
 #include <algorithm>
 #include <array>
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_template_test_macros.hpp>
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/matchers/catch_matchers_all.hpp>
@@ -10,11 +11,18 @@
 #include <list>
 #include <memory>
 #include <numeric>
+#include <random>
+#include <ranges>
 #include <string>
 #include <vector>
 #include <set>
 
+#include "flat_indexed_set.hpp"
+#include "order_statistic_set.hpp"
+#include "poly_collection.hpp"
+#include "shape_store.hpp"
 #include "stack.hpp"
+#include "static_vector.hpp"
 
 #ifdef _MSC_VER
 #define __PRETTY_FUNCTION__ __FUNCSIG__
@@ -137,6 +145,131 @@ TEST_CASE("Popping all items")
     REQUIRE(values.size() == 2);
 }
 
+TEST_CASE("Bulk operations", "[stack,push,pop]")
+{
+    Stack<std::string> s;
+    s.push_range(std::vector<std::string>{"one", "two", "three", "four"});
+
+    SECTION("push_range pushes items in order")
+    {
+        REQUIRE(s.size() == 4);
+        REQUIRE(s.top() == "four");
+    }
+
+    SECTION("pop moves the top item out")
+    {
+        std::string item = s.pop();
+
+        REQUIRE(item == "four");
+        REQUIRE(s.size() == 3);
+    }
+
+    SECTION("pop_n pops n items in LIFO order")
+    {
+        std::vector<std::string> items;
+
+        s.pop_n(std::back_inserter(items), 3);
+
+        REQUIRE(items == std::vector<std::string>{"four", "three", "two"});
+        REQUIRE(s.size() == 1);
+    }
+
+    SECTION("drain returns the storage and leaves stack empty")
+    {
+        std::deque<std::string> items = s.drain();
+
+        REQUIRE(items == std::deque<std::string>{"one", "two", "three", "four"});
+        REQUIRE(s.empty());
+    }
+}
+
+TEST_CASE("Bulk operations - move-only items", "[stack,push,pop]")
+{
+    TemplateTemplateParam::Stack<std::unique_ptr<int>, std::vector> s;
+
+    std::vector<std::unique_ptr<int>> ptrs;
+    ptrs.push_back(std::make_unique<int>(1));
+    ptrs.push_back(std::make_unique<int>(2));
+
+    s.push_range(ptrs | std::views::transform([](auto& ptr) { return std::move(ptr); }));
+
+    REQUIRE(*s.pop() == 2);
+    REQUIRE(s.drain().size() == 1);
+}
+
+TEST_CASE("Stack with StaticVector", "[stack]")
+{
+    SECTION("items are stored inline")
+    {
+        Stack<int, StaticVector<int, 16>> s;
+
+        s.push_range(std::vector{1, 2, 3});
+
+        REQUIRE(s.pop() == 3);
+        REQUIRE(s.top() == 2);
+        REQUIRE(s.drain() == StaticVector<int, 16>{1, 2});
+    }
+
+    SECTION("push into full storage with OverflowPolicy::ReportFailure returns false")
+    {
+        Stack<int, StaticVector<int, 2, OverflowPolicy::ReportFailure>> s;
+
+        REQUIRE(s.push(1));
+        REQUIRE(s.push(2));
+        REQUIRE_FALSE(s.push(3));
+        REQUIRE(s.size() == 2);
+        REQUIRE(s.top() == 2);
+
+        s.pop();
+        REQUIRE_FALSE(s.push_range(std::vector{4, 5, 6}));
+        REQUIRE(s.top() == 4);
+    }
+
+    SECTION("push into full storage with OverflowPolicy::Throw")
+    {
+        Stack<int, StaticVector<int, 1>> s;
+
+        static_assert(!ReportsPushFailure<StaticVector<int, 1>, int>);
+        s.push(1);
+        REQUIRE_THROWS_AS(s.push(2), std::length_error);
+    }
+}
+
+TEST_CASE("Draining a stack of strings", "[.][benchmark][stack]")
+{
+    constexpr int count = 1'000;
+
+    auto make_stack = [] {
+        Stack<std::string> s;
+        for (int i = 0; i < count; ++i)
+            s.push(std::string(64, 'a' + i % 26));
+        return s;
+    };
+
+    BENCHMARK_ADVANCED("pop_all")(Catch::Benchmark::Chronometer meter)
+    {
+        std::vector<Stack<std::string>> stacks(meter.runs(), make_stack());
+        meter.measure([&stacks](int i) { return pop_all(stacks[i]); });
+    };
+
+    BENCHMARK_ADVANCED("pop_n")(Catch::Benchmark::Chronometer meter)
+    {
+        std::vector<Stack<std::string>> stacks(meter.runs(), make_stack());
+        meter.measure([&stacks](int i) {
+            std::vector<std::string> values;
+            values.reserve(stacks[i].size());
+            stacks[i].pop_n(std::back_inserter(values), stacks[i].size());
+            return values;
+        });
+    };
+
+    BENCHMARK_ADVANCED("drain")(Catch::Benchmark::Chronometer meter)
+    {
+        std::vector<Stack<std::string>> stacks(meter.runs(), make_stack());
+        meter.measure([&stacks](int i) { return stacks[i].drain(); });
+    };
+}
+
 
 template <typename T>
 class IndexedSet : public std::set<T>
@@ -163,6 +296,193 @@ TEST_CASE("Inherit from std container")
     REQUIRE(my_set[2] == 3);
 }
 
+TEMPLATE_TEST_CASE("Indexed sets", "[indexed_set]", IndexedSet<int>, OrderStatisticSet<int>, FlatIndexedSet<int>, (FlatIndexedSet<int, std::less<int>, EytzingerLayout>))
+{
+    TestType my_set = {6, 1, 4, 2, 5, 7};
+    my_set.insert(3);
+
+    SECTION("items are ordered")
+    {
+        REQUIRE(std::vector<int>(my_set.begin(), my_set.end()) == std::vector{1, 2, 3, 4, 5, 6, 7});
+    }
+
+    SECTION("indexed access")
+    {
+        REQUIRE(my_set[0] == 1);
+        REQUIRE(my_set[2] == 3);
+        REQUIRE(my_set[6] == 7);
+    }
+
+    SECTION("erase")
+    {
+        REQUIRE(my_set.erase(3) == 1);
+        REQUIRE(my_set.erase(3) == 0);
+
+        REQUIRE(my_set.find(3) == my_set.end());
+        REQUIRE(my_set[2] == 4);
+    }
+}
+
+TEST_CASE("OrderStatisticSet", "[indexed_set]")
+{
+    OrderStatisticSet<int> my_set;
+    std::set<int> reference_set;
+
+    std::mt19937 rnd{665};
+    std::uniform_int_distribution<int> values{0, 1000};
+
+    for (int i = 0; i < 5000; ++i)
+    {
+        int value = values(rnd);
+
+        if (i % 3 == 0)
+        {
+            REQUIRE(my_set.erase(value) == reference_set.erase(value));
+        }
+        else
+        {
+            REQUIRE(my_set.insert(value).second == reference_set.insert(value).second);
+        }
+    }
+
+    REQUIRE(my_set.size() == reference_set.size());
+    REQUIRE(std::equal(my_set.begin(), my_set.end(), reference_set.begin(), reference_set.end()));
+    REQUIRE(std::equal(std::make_reverse_iterator(my_set.end()), std::make_reverse_iterator(my_set.begin()), reference_set.rbegin(), reference_set.rend()));
+
+    SECTION("operator[] & rank")
+    {
+        size_t index = 0;
+        for (int value : reference_set)
+        {
+            REQUIRE(my_set[index] == value);
+            REQUIRE(my_set.rank(value) == index);
+            ++index;
+        }
+    }
+
+    SECTION("erase by iterator")
+    {
+        auto it = my_set.begin();
+        while (it != my_set.end())
+            it = my_set.erase(it);
+
+        REQUIRE(my_set.empty());
+    }
+
+    SECTION("copy")
+    {
+        OrderStatisticSet<int> copy = my_set;
+
+        REQUIRE(copy == my_set);
+    }
+}
+
+TEMPLATE_TEST_CASE("FlatIndexedSet", "[indexed_set]", SortedLayout, EytzingerLayout)
+{
+    FlatIndexedSet<int, std::less<int>, TestType> my_set;
+    std::set<int> reference_set;
+
+    std::mt19937 rnd{665};
+    std::uniform_int_distribution<int> values{0, 1000};
+
+    for (int i = 0; i < 300; ++i)
+    {
+        int value = values(rnd);
+        REQUIRE(my_set.insert(value).second == reference_set.insert(value).second);
+    }
+
+    SECTION("insert_range merges a batch")
+    {
+        std::vector<int> batch(500);
+        std::generate(batch.begin(), batch.end(), [&] { return values(rnd); });
+
+        my_set.insert_range(batch);
+        reference_set.insert(batch.begin(), batch.end());
+
+        REQUIRE(std::equal(my_set.begin(), my_set.end(), reference_set.begin(), reference_set.end()));
+    }
+
+    SECTION("lookup")
+    {
+        for (int value = -1; value <= 1001; ++value)
+        {
+            REQUIRE(my_set.contains(value) == reference_set.contains(value));
+            REQUIRE(my_set.rank(value) == static_cast<size_t>(std::distance(reference_set.begin(), reference_set.lower_bound(value))));
+        }
+    }
+}
+
+TEST_CASE("Read-mostly sets", "[.][benchmark][indexed_set]")
+{
+    constexpr int size = 100'000;
+
+    std::vector<int> items(size);
+    std::iota(items.begin(), items.end(), 0);
+    std::shuffle(items.begin(), items.end(), std::mt19937{42});
+
+    std::vector<int> keys(1'000);
+    std::generate(keys.begin(), keys.end(), [rnd = std::mt19937{7}]() mutable { return static_cast<int>(rnd() % size); });
+
+    auto benchmark_set = [&]<typename TSet>(const std::string& name, std::type_identity<TSet>) {
+        BENCHMARK(name + " - bulk load")
+        {
+            return TSet(items.begin(), items.end());
+        };
+
+        TSet my_set(items.begin(), items.end());
+
+        BENCHMARK(name + " - lookup")
+        {
+            size_t found = 0;
+            for (int key : keys)
+                found += my_set.count(key);
+            return found;
+        };
+
+        BENCHMARK(name + " - iteration")
+        {
+            return std::accumulate(my_set.begin(), my_set.end(), 0LL);
+        };
+    };
+
+    benchmark_set("std::set", std::type_identity<std::set<int>>{});
+    benchmark_set("IndexedSet", std::type_identity<IndexedSet<int>>{});
+    benchmark_set("FlatIndexedSet", std::type_identity<FlatIndexedSet<int>>{});
+    benchmark_set("FlatIndexedSet<Eytzinger>", std::type_identity<FlatIndexedSet<int, std::less<int>, EytzingerLayout>>{});
+}
+
+TEST_CASE("Indexed access", "[.][benchmark][indexed_set]")
+{
+    for (int size : {1'000, 10'000, 100'000})
+    {
+        std::vector<int> items(size);
+        std::iota(items.begin(), items.end(), 0);
+        std::shuffle(items.begin(), items.end(), std::mt19937{42});
+
+        IndexedSet<int> indexed_set(items.begin(), items.end());
+        OrderStatisticSet<int> order_statistic_set(items.begin(), items.end());
+
+        std::vector<size_t> indexes(10);
+        std::generate(indexes.begin(), indexes.end(), [rnd = std::mt19937{7}, size]() mutable { return rnd() % size; });
+
+        BENCHMARK("IndexedSet::operator[] - " + std::to_string(size) + " items")
+        {
+            int sum = 0;
+            for (size_t index : indexes)
+                sum += indexed_set[index];
+            return sum;
+        };
+
+        BENCHMARK("OrderStatisticSet::operator[] - " + std::to_string(size) + " items")
+        {
+            int sum = 0;
+            for (size_t index : indexes)
+                sum += order_statistic_set[index];
+            return sum;
+        };
+    }
+}
+
 /////////////////////////////////////////////
 
 struct ShapeBase
@@ -234,14 +554,155 @@ TEST_CASE("virtual destructors")
     shapes.push_back(std::make_unique<Circle>(160));
 
     for(const auto& ptr_s : shapes)
-        ptr_s->draw();    
+        ptr_s->draw();
 }
 
-template <typename T>
-concept Shape = requires(T s, int dx, int dy) {
-    s.draw();
-    s.move(dx, dy);
-};
+TEST_CASE("PolyCollection", "[poly_collection]")
+{
+    PolyCollection<ShapeBase> shapes;
+
+    shapes.emplace<ColorCircle>(100);
+    shapes.emplace<Circle>(160);
+    shapes.insert(ColorCircle{200});
+    shapes.emplace<Circle>(260);
+
+    SECTION("items of the same type share a segment")
+    {
+        REQUIRE(shapes.size() == 4);
+        REQUIRE(shapes.segment_count() == 2);
+        REQUIRE(shapes.segment<Circle>().size() == 2);
+        REQUIRE(shapes.segment<ColorCircle>()[1].radius == 200);
+    }
+
+    SECTION("for_each visits items segment by segment")
+    {
+        std::vector<int> radiuses;
+        shapes.for_each([&](ShapeBase& s) {
+            s.draw();
+            radiuses.push_back(static_cast<Circle&>(s).radius);
+        });
+
+        REQUIRE(radiuses == std::vector{100, 200, 160, 260});
+    }
+
+    SECTION("for_each with restituted concrete types")
+    {
+        int circles = 0;
+        int other_shapes = 0;
+
+        shapes.for_each<Circle>([&](auto& s) {
+            if constexpr (std::is_same_v<std::remove_cvref_t<decltype(s)>, Circle>)
+                ++circles;
+            else
+                ++other_shapes;
+        });
+
+        REQUIRE(circles == 2);
+        REQUIRE(other_shapes == 2);
+    }
+
+    SECTION("clear")
+    {
+        shapes.clear();
+
+        REQUIRE(shapes.empty());
+    }
+}
+
+namespace Benchmark
+{
+    // shapes without I/O in draw() - only the cost of dispatch & memory access is measured
+    inline long drawn = 0;
+
+    struct Square final : ShapeBase
+    {
+        int side;
+
+        explicit Square(int s) : side{s}
+        {}
+
+        void draw() const override
+        {
+            drawn += side * side;
+        }
+    };
+
+    struct Segment final : ShapeBase
+    {
+        int length;
+
+        explicit Segment(int l) : length{l}
+        {}
+
+        void draw() const override
+        {
+            drawn += length;
+        }
+    };
+
+    struct Dot final : ShapeBase
+    {
+        void draw() const override
+        {
+            ++drawn;
+        }
+    };
+}
+
+TEST_CASE("Drawing shapes", "[.][benchmark][poly_collection]")
+{
+    constexpr int count = 1'000'000;
+
+    std::mt19937 rnd{665};
+    std::uniform_int_distribution<int> type_distr{0, 2};
+
+    std::vector<std::unique_ptr<ShapeBase>> shape_ptrs;
+    shape_ptrs.reserve(count);
+    PolyCollection<ShapeBase> shapes;
+
+    for (int i = 0; i < count; ++i)
+    {
+        switch (type_distr(rnd))
+        {
+        case 0:
+            shape_ptrs.push_back(std::make_unique<Benchmark::Square>(i % 100));
+            shapes.emplace<Benchmark::Square>(i % 100);
+            break;
+        case 1:
+            shape_ptrs.push_back(std::make_unique<Benchmark::Segment>(i % 100));
+            shapes.emplace<Benchmark::Segment>(i % 100);
+            break;
+        default:
+            shape_ptrs.push_back(std::make_unique<Benchmark::Dot>());
+            shapes.emplace<Benchmark::Dot>();
+        }
+    }
+
+    // objects of a long running program are rarely allocated in iteration order
+    std::ranges::shuffle(shape_ptrs, rnd);
+
+    BENCHMARK("std::vector<std::unique_ptr<ShapeBase>>")
+    {
+        Benchmark::drawn = 0;
+        for (const auto& ptr_s : shape_ptrs)
+            ptr_s->draw();
+        return Benchmark::drawn;
+    };
+
+    BENCHMARK("PolyCollection<ShapeBase>")
+    {
+        Benchmark::drawn = 0;
+        shapes.for_each([](const ShapeBase& s) { s.draw(); });
+        return Benchmark::drawn;
+    };
+
+    BENCHMARK("PolyCollection<ShapeBase> - restituted types")
+    {
+        Benchmark::drawn = 0;
+        shapes.for_each<Benchmark::Square, Benchmark::Segment, Benchmark::Dot>([](const auto& s) { s.draw(); });
+        return Benchmark::drawn;
+    };
+}
 
 struct Rectangle
 {
@@ -252,4 +713,195 @@ struct Rectangle
     {}
 };
 
-static_assert(Shape<Rectangle>);
\ No newline at end of file
+static_assert(Shape<Rectangle>);
+
+struct Square
+{
+    int x = 0;
+    int y = 0;
+    int size = 1;
+
+    void draw()
+    {
+        std::cout << "Drawing square at (" << x << ", " << y << ")...\n";
+    }
+
+    void move(int dx, int dy)
+    {
+        x += dx;
+        y += dy;
+    }
+};
+
+static_assert(Shape<Square>);
+
+TEST_CASE("ShapeStore", "[shape_store]")
+{
+    ShapeStore<Rectangle, Square> shapes;
+
+    shapes.insert(Square{0, 0, 10});
+    shapes.insert(Rectangle{});
+    shapes.emplace<Square>(5, 5, 20);
+
+    SECTION("shapes are grouped by type")
+    {
+        REQUIRE(shapes.size() == 3);
+        REQUIRE(shapes.segment<Rectangle>().size() == 1);
+        REQUIRE(shapes.segment<Square>()[1].size == 20);
+    }
+
+    SECTION("move_all")
+    {
+        shapes.move_all(1, 2);
+
+        REQUIRE(shapes.segment<Square>()[0].x == 1);
+        REQUIRE(shapes.segment<Square>()[1].y == 7);
+    }
+
+    SECTION("for_each passes shapes with their concrete types")
+    {
+        int area = 0;
+        shapes.for_each([&](auto& s) {
+            if constexpr (std::is_same_v<std::remove_cvref_t<decltype(s)>, Square>)
+                area += s.size * s.size;
+        });
+
+        REQUIRE(area == 500);
+    }
+
+    SECTION("draw_all & clear")
+    {
+        shapes.draw_all();
+        shapes.clear();
+
+        REQUIRE(shapes.empty());
+    }
+}
+
+namespace Benchmark
+{
+    struct MovableShape : ShapeBase
+    {
+        virtual void move(int dx, int dy) = 0;
+    };
+
+    struct VirtualBox final : MovableShape
+    {
+        int x, y, width, height;
+
+        VirtualBox(int x, int y, int w, int h) : x{x}, y{y}, width{w}, height{h}
+        {}
+
+        void draw() const override
+        {
+            drawn += width * height;
+        }
+
+        void move(int dx, int dy) override
+        {
+            x += dx;
+            y += dy;
+        }
+    };
+
+    struct VirtualPixel final : MovableShape
+    {
+        int x, y;
+
+        VirtualPixel(int x, int y) : x{x}, y{y}
+        {}
+
+        void draw() const override
+        {
+            ++drawn;
+        }
+
+        void move(int dx, int dy) override
+        {
+            x += dx;
+            y += dy;
+        }
+    };
+
+    struct Box
+    {
+        int x, y, width, height;
+
+        void draw() const
+        {
+            drawn += width * height;
+        }
+
+        void move(int dx, int dy)
+        {
+            x += dx;
+            y += dy;
+        }
+    };
+
+    struct Pixel
+    {
+        int x, y;
+
+        void draw() const
+        {
+            ++drawn;
+        }
+
+        void move(int dx, int dy)
+        {
+            x += dx;
+            y += dy;
+        }
+    };
+}
+
+TEST_CASE("Moving & drawing shapes", "[.][benchmark][shape_store]")
+{
+    constexpr int count = 1'000'000;
+
+    std::vector<std::unique_ptr<Benchmark::MovableShape>> shape_ptrs;
+    shape_ptrs.reserve(count);
+    ShapeStore<Benchmark::Box, Benchmark::Pixel> shapes;
+    shapes.reserve(count);
+
+    for (int i = 0; i < count; ++i)
+    {
+        if (i % 2 == 0)
+        {
+            shape_ptrs.push_back(std::make_unique<Benchmark::VirtualBox>(i, i, i % 10, i % 20));
+            shapes.emplace<Benchmark::Box>(i, i, i % 10, i % 20);
+        }
+        else
+        {
+            shape_ptrs.push_back(std::make_unique<Benchmark::VirtualPixel>(i, i));
+            shapes.emplace<Benchmark::Pixel>(i, i);
+        }
+    }
+
+    BENCHMARK("move - ShapeBase virtual path")
+    {
+        for (const auto& ptr_s : shape_ptrs)
+            ptr_s->move(1, -1);
+    };
+
+    BENCHMARK("move - ShapeStore")
+    {
+        shapes.move_all(1, -1);
+    };
+
+    BENCHMARK("draw - ShapeBase virtual path")
+    {
+        Benchmark::drawn = 0;
+        for (const auto& ptr_s : shape_ptrs)
+            ptr_s->draw();
+        return Benchmark::drawn;
+    };
+
+    BENCHMARK("draw - ShapeStore")
+    {
+        Benchmark::drawn = 0;
+        shapes.draw_all();
+        return Benchmark::drawn;
+    };
+}
@@ -0,0 +1,280 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <ranges>
+#include <utility>
+#include <vector>
+
+// Search layouts for FlatIndexedSet
+
+// branchless binary search directly over the sorted items
+struct SortedLayout
+{
+    template <typename T, typename TCompare>
+    class Index
+    {
+    public:
+        void rebuild(const std::vector<T>&)
+        {
+        }
+
+        std::size_t lower_bound(const std::vector<T>& items, const T& value, const TCompare& compare) const
+        {
+            if (items.empty())
+                return 0;
+
+            const T* base = items.data();
+            std::size_t length = items.size();
+
+            while (length > 1)
+            {
+                const std::size_t half = length / 2;
+                base = compare(base[half], value) ? base + half : base;
+                length -= half;
+            }
+
+            return static_cast<std::size_t>(base - items.data()) + compare(*base, value);
+        }
+    };
+};
+
+// copy of the keys in BFS (Eytzinger) order - top levels of the implicit tree share cache lines
+// and the search loop is branchless; rebuilt on every modification (read-mostly workloads)
+struct EytzingerLayout
+{
+    template <typename T, typename TCompare>
+    class Index
+    {
+        std::vector<T> keys;                // 1-based: children of k are 2k and 2k + 1
+        std::vector<std::size_t> positions; // index in sorted items of keys[k]
+
+        std::size_t fill(const std::vector<T>& items, std::size_t sorted_index, std::size_t k)
+        {
+            if (k < keys.size())
+            {
+                sorted_index = fill(items, sorted_index, 2 * k);
+                keys[k] = items[sorted_index];
+                positions[k] = sorted_index++;
+                sorted_index = fill(items, sorted_index, 2 * k + 1);
+            }
+
+            return sorted_index;
+        }
+
+    public:
+        void rebuild(const std::vector<T>& items)
+        {
+            keys.assign(items.size() + 1, T{});
+            positions.assign(items.size() + 1, 0);
+            fill(items, 0, 1);
+        }
+
+        std::size_t lower_bound(const std::vector<T>& items, const T& value, const TCompare& compare) const
+        {
+            std::size_t k = 1;
+
+            while (k < keys.size())
+                k = 2 * k + compare(keys[k], value);
+
+            k >>= std::countr_one(k) + 1; // cancels the trailing right turns
+
+            return k == 0 ? items.size() : positions[k];
+        }
+    };
+};
+
+// Ordered set stored in a sorted vector - O(1) access by index
+template <typename T, typename TCompare = std::less<T>, typename TLayout = SortedLayout>
+class FlatIndexedSet
+{
+    std::vector<T> items;
+    typename TLayout::template Index<T, TCompare> index;
+    [[no_unique_address]] TCompare compare{};
+
+    bool equivalent(const T& a, const T& b) const
+    {
+        return !compare(a, b) && !compare(b, a);
+    }
+
+public:
+    using key_type = T;
+    using value_type = T;
+    using key_compare = TCompare;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = const T&;
+    using const_reference = const T&;
+    using iterator = typename std::vector<T>::const_iterator;
+    using const_iterator = iterator;
+
+    FlatIndexedSet() = default;
+
+    template <std::input_iterator TInputIterator>
+    FlatIndexedSet(TInputIterator first, TInputIterator last)
+    {
+        insert_range(std::ranges::subrange(first, last));
+    }
+
+    FlatIndexedSet(std::initializer_list<T> il)
+    {
+        insert_range(il);
+    }
+
+    iterator begin() const
+    {
+        return items.begin();
+    }
+
+    iterator end() const
+    {
+        return items.end();
+    }
+
+    iterator cbegin() const
+    {
+        return items.begin();
+    }
+
+    iterator cend() const
+    {
+        return items.end();
+    }
+
+    std::size_t size() const
+    {
+        return items.size();
+    }
+
+    bool empty() const
+    {
+        return items.empty();
+    }
+
+    void clear()
+    {
+        items.clear();
+        index.rebuild(items);
+    }
+
+    void reserve(std::size_t capacity)
+    {
+        items.reserve(capacity);
+    }
+
+    template <typename TValue>
+    std::pair<iterator, bool> insert(TValue&& value)
+    {
+        auto pos = items.begin() + rank(value);
+
+        if (pos != items.end() && equivalent(*pos, value))
+            return {pos, false};
+
+        pos = items.insert(pos, std::forward<TValue>(value));
+        index.rebuild(items);
+
+        return {pos, true};
+    }
+
+    template <std::input_iterator TInputIterator>
+    void insert(TInputIterator first, TInputIterator last)
+    {
+        insert_range(std::ranges::subrange(first, last));
+    }
+
+    // appends the batch, sorts it and merges it with the items in one pass
+    template <std::ranges::input_range TRange>
+    void insert_range(TRange&& range)
+    {
+        const auto old_size = static_cast<std::ptrdiff_t>(items.size());
+
+        for (auto&& item : range)
+            items.push_back(std::forward<decltype(item)>(item));
+
+        const auto middle = items.begin() + old_size;
+        std::sort(middle, items.end(), compare);
+        std::inplace_merge(items.begin(), middle, items.end(), compare);
+
+        // merge is stable - for equivalent items the one already in the set comes first and is kept
+        items.erase(std::unique(items.begin(), items.end(), [this](const T& a, const T& b) { return equivalent(a, b); }), items.end());
+
+        index.rebuild(items);
+    }
+
+    iterator erase(iterator pos)
+    {
+        auto next = items.erase(pos);
+        index.rebuild(items);
+        return next;
+    }
+
+    std::size_t erase(const T& value)
+    {
+        auto pos = find(value);
+        if (pos == end())
+            return 0;
+
+        erase(pos);
+        return 1;
+    }
+
+    iterator lower_bound(const T& value) const
+    {
+        return items.begin() + rank(value);
+    }
+
+    iterator upper_bound(const T& value) const
+    {
+        return std::upper_bound(items.begin(), items.end(), value, compare);
+    }
+
+    iterator find(const T& value) const
+    {
+        auto pos = lower_bound(value);
+
+        if (pos != items.end() && !compare(value, *pos))
+            return pos;
+
+        return end();
+    }
+
+    bool contains(const T& value) const
+    {
+        return find(value) != end();
+    }
+
+    std::size_t count(const T& value) const
+    {
+        return contains(value) ? 1 : 0;
+    }
+
+    // number of items less than value
+    std::size_t rank(const T& value) const
+    {
+        return index.lower_bound(items, value, compare);
+    }
+
+    const T& operator[](std::size_t position) const
+    {
+        return items[position];
+    }
+
+    const T& at(std::size_t position) const
+    {
+        return items.at(position);
+    }
+
+    const T* data() const
+    {
+        return items.data();
+    }
+
+    friend bool operator==(const FlatIndexedSet& lhs, const FlatIndexedSet& rhs)
+    {
+        return lhs.items == rhs.items;
+    }
+};
@@ -0,0 +1,593 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+
+// Ordered set with O(log n) access by index - AVL tree augmented with subtree sizes
+template <typename T, typename TCompare = std::less<T>>
+class OrderStatisticSet
+{
+    struct Node
+    {
+        T value;
+        Node* left = nullptr;
+        Node* right = nullptr;
+        Node* parent = nullptr;
+        std::size_t size = 1;
+        int height = 1;
+    };
+
+    Node* root = nullptr;
+    [[no_unique_address]] TCompare compare{};
+
+    static std::size_t size_of(const Node* node)
+    {
+        return node ? node->size : 0;
+    }
+
+    static int height_of(const Node* node)
+    {
+        return node ? node->height : 0;
+    }
+
+    static void update(Node* node)
+    {
+        node->size = 1 + size_of(node->left) + size_of(node->right);
+        node->height = 1 + std::max(height_of(node->left), height_of(node->right));
+    }
+
+    static Node* leftmost(Node* node)
+    {
+        while (node->left)
+            node = node->left;
+        return node;
+    }
+
+    static Node* rightmost(Node* node)
+    {
+        while (node->right)
+            node = node->right;
+        return node;
+    }
+
+    void replace_child(Node* parent, Node* old_child, Node* new_child)
+    {
+        if (!parent)
+            root = new_child;
+        else if (parent->left == old_child)
+            parent->left = new_child;
+        else
+            parent->right = new_child;
+
+        if (new_child)
+            new_child->parent = parent;
+    }
+
+    Node* rotate_left(Node* node)
+    {
+        Node* pivot = node->right;
+
+        node->right = pivot->left;
+        if (pivot->left)
+            pivot->left->parent = node;
+
+        replace_child(node->parent, node, pivot);
+        pivot->left = node;
+        node->parent = pivot;
+
+        update(node);
+        update(pivot);
+
+        return pivot;
+    }
+
+    Node* rotate_right(Node* node)
+    {
+        Node* pivot = node->left;
+
+        node->left = pivot->right;
+        if (pivot->right)
+            pivot->right->parent = node;
+
+        replace_child(node->parent, node, pivot);
+        pivot->right = node;
+        node->parent = pivot;
+
+        update(node);
+        update(pivot);
+
+        return pivot;
+    }
+
+    // restores sizes & AVL balance on the path from node to the root
+    void rebalance_from(Node* node)
+    {
+        while (node)
+        {
+            update(node);
+
+            const int balance = height_of(node->left) - height_of(node->right);
+
+            if (balance > 1)
+            {
+                if (height_of(node->left->left) < height_of(node->left->right))
+                    rotate_left(node->left);
+                node = rotate_right(node);
+            }
+            else if (balance < -1)
+            {
+                if (height_of(node->right->right) < height_of(node->right->left))
+                    rotate_right(node->right);
+                node = rotate_left(node);
+            }
+
+            node = node->parent;
+        }
+    }
+
+    void erase_node(Node* node)
+    {
+        Node* rebalance_start = node->parent;
+
+        if (!node->left)
+        {
+            replace_child(node->parent, node, node->right);
+        }
+        else if (!node->right)
+        {
+            replace_child(node->parent, node, node->left);
+        }
+        else
+        {
+            Node* successor = leftmost(node->right);
+
+            if (successor->parent != node)
+            {
+                rebalance_start = successor->parent;
+                replace_child(successor->parent, successor, successor->right);
+                successor->right = node->right;
+                successor->right->parent = successor;
+            }
+            else
+            {
+                rebalance_start = successor;
+            }
+
+            replace_child(node->parent, node, successor);
+            successor->left = node->left;
+            successor->left->parent = successor;
+        }
+
+        delete node;
+        rebalance_from(rebalance_start);
+    }
+
+    static Node* clone(const Node* node, Node* parent)
+    {
+        if (!node)
+            return nullptr;
+
+        Node* copy = new Node{node->value, nullptr, nullptr, parent, node->size, node->height};
+        try
+        {
+            copy->left = clone(node->left, copy);
+            copy->right = clone(node->right, copy);
+        }
+        catch (...)
+        {
+            destroy(copy);
+            throw;
+        }
+
+        return copy;
+    }
+
+    static void destroy(Node* node)
+    {
+        if (!node)
+            return;
+
+        destroy(node->left);
+        destroy(node->right);
+        delete node;
+    }
+
+    template <typename TKey>
+    Node* lower_bound_node(const TKey& key) const
+    {
+        Node* result = nullptr;
+
+        for (Node* node = root; node;)
+        {
+            if (compare(node->value, key))
+                node = node->right;
+            else
+            {
+                result = node;
+                node = node->left;
+            }
+        }
+
+        return result;
+    }
+
+    template <typename TValue>
+    std::pair<Node*, bool> insert_node(TValue&& value)
+    {
+        Node* parent = nullptr;
+        Node** link = &root;
+
+        while (*link)
+        {
+            parent = *link;
+
+            if (compare(value, parent->value))
+                link = &parent->left;
+            else if (compare(parent->value, value))
+                link = &parent->right;
+            else
+                return {parent, false};
+        }
+
+        Node* node = new Node{std::forward<TValue>(value)};
+        node->parent = parent;
+        *link = node;
+
+        rebalance_from(parent);
+
+        return {node, true};
+    }
+
+public:
+    class iterator
+    {
+        friend class OrderStatisticSet;
+
+        const OrderStatisticSet* set = nullptr;
+        Node* node = nullptr;
+
+        iterator(const OrderStatisticSet* owner, Node* position)
+            : set{owner}
+            , node{position}
+        {
+        }
+
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        iterator() = default;
+
+        reference operator*() const
+        {
+            return node->value;
+        }
+
+        pointer operator->() const
+        {
+            return &node->value;
+        }
+
+        iterator& operator++()
+        {
+            if (node->right)
+            {
+                node = leftmost(node->right);
+            }
+            else
+            {
+                Node* parent = node->parent;
+                while (parent && node == parent->right)
+                {
+                    node = parent;
+                    parent = parent->parent;
+                }
+                node = parent;
+            }
+
+            return *this;
+        }
+
+        iterator operator++(int)
+        {
+            iterator temp = *this;
+            ++*this;
+            return temp;
+        }
+
+        iterator& operator--()
+        {
+            if (!node)
+            {
+                node = rightmost(set->root);
+            }
+            else if (node->left)
+            {
+                node = rightmost(node->left);
+            }
+            else
+            {
+                Node* parent = node->parent;
+                while (parent && node == parent->left)
+                {
+                    node = parent;
+                    parent = parent->parent;
+                }
+                node = parent;
+            }
+
+            return *this;
+        }
+
+        iterator operator--(int)
+        {
+            iterator temp = *this;
+            --*this;
+            return temp;
+        }
+
+        bool operator==(const iterator& other) const
+        {
+            return node == other.node;
+        }
+    };
+
+    using key_type = T;
+    using value_type = T;
+    using key_compare = TCompare;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = const T&;
+    using const_reference = const T&;
+    using const_iterator = iterator;
+
+    OrderStatisticSet() = default;
+
+    explicit OrderStatisticSet(const TCompare& comp)
+        : compare{comp}
+    {
+    }
+
+    template <std::input_iterator TInputIterator>
+    OrderStatisticSet(TInputIterator first, TInputIterator last)
+    {
+        insert(first, last);
+    }
+
+    OrderStatisticSet(std::initializer_list<T> il)
+    {
+        insert(il.begin(), il.end());
+    }
+
+    OrderStatisticSet(const OrderStatisticSet& other)
+        : root{clone(other.root, nullptr)}
+        , compare{other.compare}
+    {
+    }
+
+    OrderStatisticSet(OrderStatisticSet&& other) noexcept
+        : root{std::exchange(other.root, nullptr)}
+        , compare{std::move(other.compare)}
+    {
+    }
+
+    OrderStatisticSet& operator=(const OrderStatisticSet& other)
+    {
+        if (this != &other)
+        {
+            OrderStatisticSet temp(other);
+            swap(temp);
+        }
+
+        return *this;
+    }
+
+    OrderStatisticSet& operator=(OrderStatisticSet&& other) noexcept
+    {
+        if (this != &other)
+        {
+            clear();
+            swap(other);
+        }
+
+        return *this;
+    }
+
+    ~OrderStatisticSet()
+    {
+        destroy(root);
+    }
+
+    void swap(OrderStatisticSet& other) noexcept
+    {
+        std::swap(root, other.root);
+        std::swap(compare, other.compare);
+    }
+
+    iterator begin() const
+    {
+        return iterator{this, root ? leftmost(root) : nullptr};
+    }
+
+    iterator end() const
+    {
+        return iterator{this, nullptr};
+    }
+
+    iterator cbegin() const
+    {
+        return begin();
+    }
+
+    iterator cend() const
+    {
+        return end();
+    }
+
+    std::size_t size() const
+    {
+        return size_of(root);
+    }
+
+    bool empty() const
+    {
+        return root == nullptr;
+    }
+
+    void clear()
+    {
+        destroy(std::exchange(root, nullptr));
+    }
+
+    std::pair<iterator, bool> insert(const T& value)
+    {
+        auto [node, inserted] = insert_node(value);
+        return {iterator{this, node}, inserted};
+    }
+
+    std::pair<iterator, bool> insert(T&& value)
+    {
+        auto [node, inserted] = insert_node(std::move(value));
+        return {iterator{this, node}, inserted};
+    }
+
+    template <std::input_iterator TInputIterator>
+    void insert(TInputIterator first, TInputIterator last)
+    {
+        for (; first != last; ++first)
+            insert_node(*first);
+    }
+
+    template <typename... TArgs>
+    std::pair<iterator, bool> emplace(TArgs&&... args)
+    {
+        return insert(T(std::forward<TArgs>(args)...));
+    }
+
+    iterator erase(iterator pos)
+    {
+        iterator next = std::next(pos);
+        erase_node(pos.node);
+        return next;
+    }
+
+    std::size_t erase(const T& value)
+    {
+        iterator pos = find(value);
+        if (pos == end())
+            return 0;
+
+        erase_node(pos.node);
+        return 1;
+    }
+
+    iterator lower_bound(const T& value) const
+    {
+        return iterator{this, lower_bound_node(value)};
+    }
+
+    iterator upper_bound(const T& value) const
+    {
+        Node* result = nullptr;
+
+        for (Node* node = root; node;)
+        {
+            if (compare(value, node->value))
+            {
+                result = node;
+                node = node->left;
+            }
+            else
+                node = node->right;
+        }
+
+        return iterator{this, result};
+    }
+
+    iterator find(const T& value) const
+    {
+        Node* node = lower_bound_node(value);
+
+        if (node && !compare(value, node->value))
+            return iterator{this, node};
+
+        return end();
+    }
+
+    bool contains(const T& value) const
+    {
+        return find(value) != end();
+    }
+
+    std::size_t count(const T& value) const
+    {
+        return contains(value) ? 1 : 0;
+    }
+
+    // number of items less than value
+    std::size_t rank(const T& value) const
+    {
+        std::size_t result = 0;
+
+        for (Node* node = root; node;)
+        {
+            if (compare(node->value, value))
+            {
+                result += size_of(node->left) + 1;
+                node = node->right;
+            }
+            else
+                node = node->left;
+        }
+
+        return result;
+    }
+
+    iterator nth(std::size_t index) const
+    {
+        Node* node = root;
+
+        while (node)
+        {
+            const std::size_t left_size = size_of(node->left);
+
+            if (index < left_size)
+                node = node->left;
+            else if (index == left_size)
+                break;
+            else
+            {
+                index -= left_size + 1;
+                node = node->right;
+            }
+        }
+
+        return iterator{this, node};
+    }
+
+    const T& operator[](std::size_t index) const
+    {
+        return *nth(index);
+    }
+
+    const T& at(std::size_t index) const
+    {
+        if (index >= size())
+            throw std::out_of_range("Index out of range");
+
+        return *nth(index);
+    }
+
+    friend bool operator==(const OrderStatisticSet& lhs, const OrderStatisticSet& rhs)
+    {
+        return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+    }
+};
@@ -0,0 +1,199 @@
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <span>
+#include <type_traits>
+#include <typeindex>
+#include <utility>
+#include <vector>
+
+// Polymorphic collection that keeps objects of each concrete type in a separate contiguous segment
+// - iteration visits segment after segment, so virtual calls inside a segment always hit the same target
+template <typename TBase>
+class PolyCollection
+{
+    class Segment
+    {
+    public:
+        const std::type_index type;
+        std::ptrdiff_t base_offset = 0; // offset of TBase subobject in the concrete type
+
+        explicit Segment(std::type_index type)
+            : type{type}
+        {
+        }
+
+        virtual ~Segment() = default;
+
+        virtual std::byte* data() = 0;
+        virtual std::size_t size() const = 0;
+        virtual std::size_t stride() const = 0;
+        virtual void clear() = 0;
+    };
+
+    template <typename T>
+    class SegmentOf : public Segment
+    {
+    public:
+        std::vector<T> items;
+
+        SegmentOf()
+            : Segment{typeid(T)}
+        {
+        }
+
+        std::byte* data() override
+        {
+            return reinterpret_cast<std::byte*>(items.data());
+        }
+
+        std::size_t size() const override
+        {
+            return items.size();
+        }
+
+        std::size_t stride() const override
+        {
+            return sizeof(T);
+        }
+
+        void clear() override
+        {
+            items.clear();
+        }
+    };
+
+    std::vector<std::unique_ptr<Segment>> segments;
+
+    template <typename T>
+    SegmentOf<T>* find_segment() const
+    {
+        auto pos = std::find_if(segments.begin(), segments.end(), [](const auto& segment) { return segment->type == typeid(T); });
+
+        return pos != segments.end() ? static_cast<SegmentOf<T>*>(pos->get()) : nullptr;
+    }
+
+    template <typename T>
+    SegmentOf<T>& segment_for()
+    {
+        if (auto* segment = find_segment<T>())
+            return *segment;
+
+        auto segment = std::make_unique<SegmentOf<T>>();
+        auto& result = *segment;
+        segments.push_back(std::move(segment));
+
+        return result;
+    }
+
+    template <typename T>
+    static void set_base_offset(SegmentOf<T>& segment)
+    {
+        T& item = segment.items.front();
+        segment.base_offset = reinterpret_cast<std::byte*>(static_cast<TBase*>(&item)) - reinterpret_cast<std::byte*>(&item);
+    }
+
+    template <typename TFunction>
+    static void for_each_in(Segment& segment, TFunction& f)
+    {
+        std::byte* item = segment.data() + segment.base_offset;
+        const std::size_t stride = segment.stride();
+
+        for (std::size_t i = 0, count = segment.size(); i < count; ++i, item += stride)
+            f(*std::launder(reinterpret_cast<TBase*>(item)));
+    }
+
+    template <typename T, typename TFunction>
+    bool try_for_each_as(Segment& segment, TFunction& f)
+    {
+        if (segment.type != typeid(T))
+            return false;
+
+        for (T& item : static_cast<SegmentOf<T>&>(segment).items)
+            f(item);
+
+        return true;
+    }
+
+public:
+    using value_type = TBase;
+
+    // T must be the dynamic type of the inserted object - it is stored by value
+    template <typename T>
+        requires std::derived_from<std::remove_cvref_t<T>, TBase>
+    std::remove_cvref_t<T>& insert(T&& item)
+    {
+        return emplace<std::remove_cvref_t<T>>(std::forward<T>(item));
+    }
+
+    template <std::derived_from<TBase> T, typename... TArgs>
+    T& emplace(TArgs&&... args)
+    {
+        auto& segment = segment_for<T>();
+        T& item = segment.items.emplace_back(std::forward<TArgs>(args)...);
+
+        if (segment.items.size() == 1)
+            set_base_offset(segment);
+
+        return item;
+    }
+
+    std::size_t size() const
+    {
+        std::size_t result = 0;
+        for (const auto& segment : segments)
+            result += segment->size();
+        return result;
+    }
+
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+    void clear()
+    {
+        for (auto& segment : segments)
+            segment->clear();
+    }
+
+    std::size_t segment_count() const
+    {
+        return segments.size();
+    }
+
+    // direct access to the segment of a concrete type
+    template <std::derived_from<TBase> T>
+    std::span<T> segment()
+    {
+        if (auto* segment = find_segment<T>())
+            return segment->items;
+
+        return {};
+    }
+
+    // calls f(TBase&) for every item - segment by segment
+    template <typename TFunction>
+    void for_each(TFunction f)
+    {
+        for (auto& segment : segments)
+            for_each_in(*segment, f);
+    }
+
+    // calls f(T&) with the concrete type for segments of types listed in Ts (calls can be devirtualized & inlined)
+    // and f(TBase&) for the rest
+    template <typename... Ts, typename TFunction>
+        requires(sizeof...(Ts) > 0)
+    void for_each(TFunction f)
+    {
+        for (auto& segment : segments)
+        {
+            if (!(try_for_each_as<Ts>(*segment, f) || ...))
+                for_each_in(*segment, f);
+        }
+    }
+};
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <span>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+template <typename T>
+concept Shape = requires(T s, int dx, int dy) {
+    s.draw();
+    s.move(dx, dy);
+};
+
+// Heterogeneous collection of shapes stored by value - one vector per type, no virtual calls
+// - loops over a vector call concrete member functions, so they can be inlined & vectorized
+template <Shape... TShapes>
+class ShapeStore
+{
+    std::tuple<std::vector<TShapes>...> shapes;
+
+    template <typename T>
+    static constexpr bool is_stored = (std::same_as<T, TShapes> || ...);
+
+    template <typename TFunction>
+    void for_each_vector(TFunction f)
+    {
+        std::apply([&f](auto&... vectors) { (f(vectors), ...); }, shapes);
+    }
+
+public:
+    template <typename T>
+        requires is_stored<std::remove_cvref_t<T>>
+    std::remove_cvref_t<T>& insert(T&& shape)
+    {
+        return emplace<std::remove_cvref_t<T>>(std::forward<T>(shape));
+    }
+
+    template <typename T, typename... TArgs>
+        requires is_stored<T>
+    T& emplace(TArgs&&... args)
+    {
+        return std::get<std::vector<T>>(shapes).emplace_back(std::forward<TArgs>(args)...);
+    }
+
+    template <typename T>
+        requires is_stored<T>
+    std::span<T> segment()
+    {
+        return std::get<std::vector<T>>(shapes);
+    }
+
+    std::size_t size() const
+    {
+        return std::apply([](const auto&... vectors) { return (vectors.size() + ... + 0); }, shapes);
+    }
+
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+    void clear()
+    {
+        for_each_vector([](auto& vector) { vector.clear(); });
+    }
+
+    void reserve(std::size_t capacity_per_type)
+    {
+        for_each_vector([capacity_per_type](auto& vector) { vector.reserve(capacity_per_type); });
+    }
+
+    // calls f with every shape - shapes of the same type are visited in one loop
+    template <typename TFunction>
+    void for_each(TFunction f)
+    {
+        for_each_vector([&f](auto& vector) {
+            for (auto& shape : vector)
+                f(shape);
+        });
+    }
+
+    void move_all(int dx, int dy)
+    {
+        for_each([dx, dy](auto& shape) { shape.move(dx, dy); });
+    }
+
+    void draw_all()
+    {
+        for_each([](auto& shape) { shape.draw(); });
+    }
+};
@@ -0,0 +1,353 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+// Vector that keeps first N items in an inline buffer and spills to the heap only beyond N
+template <typename T, std::size_t N, typename TAllocator = std::allocator<T>>
+class SmallVector
+{
+    static_assert(N > 0, "Inline capacity must be greater than zero");
+
+    using AllocTraits = std::allocator_traits<TAllocator>;
+
+    alignas(T) std::byte buffer[N * sizeof(T)];
+    T* items = inline_items();
+    std::size_t item_count = 0;
+    std::size_t item_capacity = N;
+    [[no_unique_address]] TAllocator allocator{};
+
+    T* inline_items() noexcept
+    {
+        return reinterpret_cast<T*>(buffer);
+    }
+
+    void grow(std::size_t min_capacity)
+    {
+        const std::size_t new_capacity = std::max(min_capacity, 2 * item_capacity);
+        T* new_items = AllocTraits::allocate(allocator, new_capacity);
+
+        try
+        {
+            std::uninitialized_move(items, items + item_count, new_items);
+        }
+        catch (...)
+        {
+            AllocTraits::deallocate(allocator, new_items, new_capacity);
+            throw;
+        }
+
+        release_storage();
+
+        items = new_items;
+        item_capacity = new_capacity;
+    }
+
+    // the new item is constructed before the old ones are moved - args may refer to an item of this vector
+    template <typename... TArgs>
+    T* grow_and_emplace_back(TArgs&&... args)
+    {
+        const std::size_t new_capacity = 2 * item_capacity;
+        T* new_items = AllocTraits::allocate(allocator, new_capacity);
+        T* item = nullptr;
+
+        try
+        {
+            item = std::construct_at(new_items + item_count, std::forward<TArgs>(args)...);
+            std::uninitialized_move(items, items + item_count, new_items);
+        }
+        catch (...)
+        {
+            if (item)
+                std::destroy_at(item);
+            AllocTraits::deallocate(allocator, new_items, new_capacity);
+            throw;
+        }
+
+        release_storage();
+
+        items = new_items;
+        item_capacity = new_capacity;
+        ++item_count;
+
+        return item;
+    }
+
+    void release_storage() noexcept
+    {
+        std::destroy(items, items + item_count);
+
+        if (!is_inline())
+            AllocTraits::deallocate(allocator, items, item_capacity);
+    }
+
+    void steal_from(SmallVector& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+    {
+        if (other.is_inline())
+        {
+            std::uninitialized_move(other.items, other.items + other.item_count, items);
+            item_count = other.item_count;
+            other.clear();
+        }
+        else
+        {
+            items = std::exchange(other.items, other.inline_items());
+            item_count = std::exchange(other.item_count, 0);
+            item_capacity = std::exchange(other.item_capacity, N);
+        }
+    }
+
+public:
+    using value_type = T;
+    using allocator_type = TAllocator;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = T&;
+    using const_reference = const T&;
+    using pointer = T*;
+    using const_pointer = const T*;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    static constexpr std::size_t inline_capacity = N;
+
+    SmallVector() = default;
+
+    explicit SmallVector(const TAllocator& alloc)
+        : allocator{alloc}
+    {
+    }
+
+    SmallVector(std::initializer_list<T> il, const TAllocator& alloc = TAllocator{})
+        : allocator{alloc}
+    {
+        reserve(il.size());
+
+        try
+        {
+            for (const auto& item : il)
+                push_back(item);
+        }
+        catch (...)
+        {
+            release_storage(); // the destructor is not called when a constructor throws
+            throw;
+        }
+    }
+
+    SmallVector(const SmallVector& other)
+        : allocator{AllocTraits::select_on_container_copy_construction(other.allocator)}
+    {
+        reserve(other.size());
+
+        try
+        {
+            std::uninitialized_copy(other.begin(), other.end(), items); // destroys the copied items if a copy throws
+        }
+        catch (...)
+        {
+            release_storage();
+            throw;
+        }
+
+        item_count = other.size();
+    }
+
+    SmallVector(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+        : allocator{std::move(other.allocator)}
+    {
+        steal_from(other);
+    }
+
+    SmallVector& operator=(const SmallVector& other)
+    {
+        if (this != &other)
+        {
+            SmallVector temp(other);
+            *this = std::move(temp);
+        }
+
+        return *this;
+    }
+
+    // heap storage is taken over only if the allocator propagates or both allocators are equal -
+    // otherwise memory of other's allocator would be freed by this one, so the items are moved one by one
+    SmallVector& operator=(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>
+        && (AllocTraits::propagate_on_container_move_assignment::value || AllocTraits::is_always_equal::value))
+    {
+        if (this != &other)
+        {
+            release_storage();
+            items = inline_items();
+            item_count = 0;
+            item_capacity = N;
+
+            if constexpr (AllocTraits::propagate_on_container_move_assignment::value)
+            {
+                allocator = std::move(other.allocator);
+                steal_from(other);
+            }
+            else if (AllocTraits::is_always_equal::value || allocator == other.allocator)
+            {
+                steal_from(other);
+            }
+            else
+            {
+                reserve(other.size());
+                std::uninitialized_move(other.begin(), other.end(), items);
+                item_count = other.size();
+                other.clear();
+            }
+        }
+
+        return *this;
+    }
+
+    ~SmallVector()
+    {
+        release_storage();
+    }
+
+    bool is_inline() const noexcept
+    {
+        return item_capacity == N;
+    }
+
+    std::size_t size() const noexcept
+    {
+        return item_count;
+    }
+
+    std::size_t capacity() const noexcept
+    {
+        return item_capacity;
+    }
+
+    bool empty() const noexcept
+    {
+        return item_count == 0;
+    }
+
+    void reserve(std::size_t new_capacity)
+    {
+        if (new_capacity > item_capacity)
+            grow(new_capacity);
+    }
+
+    template <typename... TArgs>
+    reference emplace_back(TArgs&&... args)
+    {
+        if (item_count == item_capacity)
+            return *grow_and_emplace_back(std::forward<TArgs>(args)...);
+
+        T* item = std::construct_at(items + item_count, std::forward<TArgs>(args)...);
+        ++item_count;
+
+        return *item;
+    }
+
+    void push_back(const T& value)
+    {
+        emplace_back(value);
+    }
+
+    void push_back(T&& value)
+    {
+        emplace_back(std::move(value));
+    }
+
+    void pop_back()
+    {
+        --item_count;
+        std::destroy_at(items + item_count);
+    }
+
+    void clear() noexcept
+    {
+        std::destroy(items, items + item_count);
+        item_count = 0;
+    }
+
+    reference back()
+    {
+        return items[item_count - 1];
+    }
+
+    const_reference back() const
+    {
+        return items[item_count - 1];
+    }
+
+    reference front()
+    {
+        return items[0];
+    }
+
+    const_reference front() const
+    {
+        return items[0];
+    }
+
+    reference operator[](std::size_t index)
+    {
+        return items[index];
+    }
+
+    const_reference operator[](std::size_t index) const
+    {
+        return items[index];
+    }
+
+    T* data() noexcept
+    {
+        return items;
+    }
+
+    const T* data() const noexcept
+    {
+        return items;
+    }
+
+    iterator begin() noexcept
+    {
+        return items;
+    }
+
+    iterator end() noexcept
+    {
+        return items + item_count;
+    }
+
+    const_iterator begin() const noexcept
+    {
+        return items;
+    }
+
+    const_iterator end() const noexcept
+    {
+        return items + item_count;
+    }
+
+    allocator_type get_allocator() const
+    {
+        return allocator;
+    }
+
+    friend bool operator==(const SmallVector& lhs, const SmallVector& rhs)
+    {
+        return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    }
+};
+
+// Binds inline capacity, so SmallVector can be passed as a template template parameter:
+// TemplateTemplateParam::Stack<int, WithInlineCapacity<32>::SmallVector>
+template <std::size_t N>
+struct WithInlineCapacity
+{
+    template <typename T, typename TAllocator>
+    using SmallVector = ::SmallVector<T, N, TAllocator>;
+};
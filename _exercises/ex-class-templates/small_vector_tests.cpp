@@ -0,0 +1,359 @@
+#include <algorithm>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <deque>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "small_vector.hpp"
+#include "stack.hpp"
+
+namespace
+{
+    std::size_t allocation_count = 0;
+    std::size_t deallocation_count = 0;
+
+    template <typename T>
+    struct CountingAllocator
+    {
+        using value_type = T;
+
+        CountingAllocator() = default;
+
+        template <typename U>
+        CountingAllocator(const CountingAllocator<U>&)
+        {
+        }
+
+        T* allocate(std::size_t n)
+        {
+            ++allocation_count;
+            return std::allocator<T>{}.allocate(n);
+        }
+
+        void deallocate(T* ptr, std::size_t n)
+        {
+            ++deallocation_count;
+            std::allocator<T>{}.deallocate(ptr, n);
+        }
+
+        friend bool operator==(const CountingAllocator&, const CountingAllocator&) = default;
+    };
+
+    // stateful allocator - memory must be returned to the allocator with the same id
+    template <typename T, bool propagate>
+    struct TaggedAllocator
+    {
+        using value_type = T;
+        using propagate_on_container_move_assignment = std::bool_constant<propagate>;
+
+        template <typename U>
+        struct rebind
+        {
+            using other = TaggedAllocator<U, propagate>;
+        };
+
+        int id;
+        std::shared_ptr<std::vector<std::pair<int, T*>>> blocks = std::make_shared<std::vector<std::pair<int, T*>>>();
+
+        explicit TaggedAllocator(int id)
+            : id{id}
+        {
+        }
+
+        T* allocate(std::size_t n)
+        {
+            T* ptr = std::allocator<T>{}.allocate(n);
+            blocks->emplace_back(id, ptr);
+            return ptr;
+        }
+
+        void deallocate(T* ptr, std::size_t n)
+        {
+            auto block = std::ranges::find(*blocks, std::pair{id, ptr});
+            CHECK(block != blocks->end()); // allocated by an allocator with the same id (no throw - called from destructors)
+            if (block != blocks->end())
+                blocks->erase(block);
+            std::allocator<T>{}.deallocate(ptr, n);
+        }
+
+        friend bool operator==(const TaggedAllocator& lhs, const TaggedAllocator& rhs)
+        {
+            return lhs.id == rhs.id;
+        }
+    };
+} // namespace
+
+static_assert(std::is_same_v<TemplateTemplateParam::Stack<int, WithInlineCapacity<32>::SmallVector>::container_type, SmallVector<int, 32>>);
+
+TEST_CASE("SmallVector", "[small_vector]")
+{
+    SmallVector<std::string, 2> vec = {"one", "two"};
+
+    SECTION("stores items inline up to N")
+    {
+        REQUIRE(vec.is_inline());
+        REQUIRE(vec.size() == 2);
+        REQUIRE(vec.back() == "two");
+    }
+
+    SECTION("spills to the heap beyond N")
+    {
+        vec.push_back("three");
+
+        REQUIRE(!vec.is_inline());
+        REQUIRE(vec == SmallVector<std::string, 2>{"one", "two", "three"});
+    }
+
+    SECTION("pop_back")
+    {
+        vec.pop_back();
+
+        REQUIRE(vec.size() == 1);
+        REQUIRE(vec.back() == "one");
+    }
+
+    SECTION("copy")
+    {
+        vec.push_back("three");
+        auto other = vec;
+
+        REQUIRE(other == vec);
+    }
+
+    SECTION("move of inline storage")
+    {
+        auto other = std::move(vec);
+
+        REQUIRE(other == SmallVector<std::string, 2>{"one", "two"});
+        REQUIRE(vec.empty());
+    }
+
+    SECTION("move of heap storage")
+    {
+        vec.push_back("three");
+        const std::string* items = vec.data();
+
+        auto other = std::move(vec);
+
+        REQUIRE(other.data() == items);
+        REQUIRE(vec.empty());
+        REQUIRE(vec.is_inline());
+    }
+}
+
+namespace
+{
+    // copy constructor throws when copy_budget is exhausted
+    struct ThrowingCopy
+    {
+        static inline int live_count = 0;
+        static inline int copy_budget = 1000;
+
+        int value;
+
+        ThrowingCopy(int value)
+            : value{value}
+        {
+            ++live_count;
+        }
+
+        ThrowingCopy(const ThrowingCopy& other)
+            : value{other.value}
+        {
+            if (copy_budget-- == 0)
+                throw std::runtime_error("copy failed");
+            ++live_count;
+        }
+
+        ~ThrowingCopy()
+        {
+            --live_count;
+        }
+
+        bool operator==(const ThrowingCopy&) const = default;
+    };
+} // namespace
+
+TEST_CASE("SmallVector - exception in constructor", "[small_vector]")
+{
+    using Vector = SmallVector<ThrowingCopy, 2, CountingAllocator<ThrowingCopy>>;
+
+    allocation_count = deallocation_count = 0;
+    ThrowingCopy::copy_budget = 1000;
+
+    {
+        Vector vec = {1, 2, 3, 4};
+        const int live_count = ThrowingCopy::live_count;
+
+        SECTION("copy constructor")
+        {
+            ThrowingCopy::copy_budget = 2;
+            REQUIRE_THROWS_AS(Vector(vec), std::runtime_error);
+        }
+
+        SECTION("initializer_list constructor")
+        {
+            ThrowingCopy::copy_budget = 2;
+            REQUIRE_THROWS_AS((Vector{5, 6, 7}), std::runtime_error);
+        }
+
+        ThrowingCopy::copy_budget = 1000;
+        REQUIRE(ThrowingCopy::live_count == live_count);
+    }
+
+    REQUIRE(ThrowingCopy::live_count == 0);
+    REQUIRE(allocation_count == deallocation_count);
+}
+
+TEST_CASE("SmallVector - move assignment with stateful allocators", "[small_vector]")
+{
+    SECTION("non-propagating allocators that differ - items are moved one by one")
+    {
+        using Allocator = TaggedAllocator<std::string, false>;
+        Allocator first_allocator{1}, second_allocator{2};
+        second_allocator.blocks = first_allocator.blocks;
+
+        SmallVector<std::string, 2, Allocator> target({"a"}, first_allocator);
+        SmallVector<std::string, 2, Allocator> source({"one", "two", "three"}, second_allocator);
+        const std::string* source_items = source.data();
+
+        target = std::move(source);
+
+        REQUIRE(target.data() != source_items);
+        REQUIRE(target.get_allocator() == first_allocator);
+        REQUIRE(target == SmallVector<std::string, 2, Allocator>({"one", "two", "three"}, first_allocator));
+        REQUIRE(source.empty());
+    }
+
+    SECTION("equal allocators - heap storage is taken over")
+    {
+        using Allocator = TaggedAllocator<std::string, false>;
+        Allocator allocator{1};
+
+        SmallVector<std::string, 2, Allocator> target(allocator);
+        SmallVector<std::string, 2, Allocator> source({"one", "two", "three"}, allocator);
+        const std::string* source_items = source.data();
+
+        target = std::move(source);
+
+        REQUIRE(target.data() == source_items);
+    }
+
+    SECTION("propagating allocator - heap storage is taken over with the allocator")
+    {
+        using Allocator = TaggedAllocator<std::string, true>;
+        Allocator first_allocator{1}, second_allocator{2};
+        second_allocator.blocks = first_allocator.blocks;
+
+        SmallVector<std::string, 2, Allocator> target({"a", "b", "c"}, first_allocator);
+        SmallVector<std::string, 2, Allocator> source({"one", "two", "three"}, second_allocator);
+        const std::string* source_items = source.data();
+
+        target = std::move(source);
+
+        REQUIRE(target.data() == source_items);
+        REQUIRE(target.get_allocator() == second_allocator);
+    }
+}
+
+TEST_CASE("Stack with SmallVector", "[stack][small_vector]")
+{
+    allocation_count = 0;
+
+    SECTION("no heap allocations below inline capacity")
+    {
+        Stack<int, SmallVector<int, 32, CountingAllocator<int>>> s;
+
+        for (int i = 0; i < 32; ++i)
+            s.push(i);
+
+        REQUIRE(allocation_count == 0);
+
+        s.push(32);
+
+        REQUIRE(allocation_count == 1);
+        REQUIRE(s.top() == 32);
+    }
+
+    SECTION("TemplateTemplateParam::Stack")
+    {
+        TemplateTemplateParam::Stack<int, WithInlineCapacity<16>::SmallVector, CountingAllocator<int>> s;
+
+        for (int i = 0; i < 16; ++i)
+            s.push(i);
+
+        int item;
+        s.pop(item);
+
+        REQUIRE(item == 15);
+        REQUIRE(allocation_count == 0);
+    }
+
+    SECTION("pushing the top item when the storage is full")
+    {
+        Stack<std::string, SmallVector<std::string, 2>> s;
+        const std::string text(40, 'x'); // not in the small string buffer - a move leaves the source empty
+
+        s.push(text);
+        s.push(text);
+        s.push(s.top());
+        s.push(s.top()); // heap storage is full again
+
+        REQUIRE(s.size() == 4);
+        REQUIRE(s.top() == text);
+        REQUIRE(s.drain() == SmallVector<std::string, 2>{text, text, text, text});
+    }
+
+    SECTION("std::deque allocates on first push")
+    {
+        Stack<int, std::deque<int, CountingAllocator<int>>> s;
+
+        s.push(1);
+
+        REQUIRE(allocation_count > 0);
+    }
+}
+
+template <typename TStack>
+int push_pop(int count)
+{
+    TStack s;
+
+    for (int i = 0; i < count; ++i)
+        s.push(i);
+
+    int sum = 0;
+    int item;
+    while (!s.empty())
+    {
+        s.pop(item);
+        sum += item;
+    }
+
+    return sum;
+}
+
+TEST_CASE("Stack backing storage", "[.][benchmark][small_vector]")
+{
+    constexpr int count = 16;
+
+    BENCHMARK("Stack<int, std::deque<int>>")
+    {
+        return push_pop<Stack<int, std::deque<int>>>(count);
+    };
+
+    BENCHMARK("Stack<int, std::vector<int>>")
+    {
+        return push_pop<Stack<int, std::vector<int>>>(count);
+    };
+
+    BENCHMARK("Stack<int, SmallVector<int, 32>>")
+    {
+        return push_pop<Stack<int, SmallVector<int, 32>>>(count);
+    };
+}
@@ -2,6 +2,31 @@
 
 #include <deque>
 #include <array>
+#include <concepts>
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+#include <utility>
+
+// push_back of a container that may fail without throwing returns bool
+// (e.g. StaticVector with OverflowPolicy::ReportFailure) - Stack passes the result on
+template <typename TContainer, typename T>
+concept ReportsPushFailure = requires(TContainer& container, T&& value) {
+    { container.push_back(std::forward<T>(value)) } -> std::same_as<bool>;
+};
+
+namespace Detail
+{
+    // empty container with the same allocator - drain() must not replace a stateful allocator with a default constructed one
+    template <typename TContainer>
+    TContainer empty_like(const TContainer& container)
+    {
+        if constexpr (requires { container.get_allocator(); })
+            return TContainer(container.get_allocator());
+        else
+            return TContainer{};
+    }
+} // namespace Detail
 
 template <typename TItem, typename TRange = std::deque<TItem>>
 class Stack
@@ -29,21 +54,90 @@ public:
         container.push_back(std::forward<T>(_value));
     }
 
+    // false if the item was not pushed (full container)
+    template <typename T>
+        requires ReportsPushFailure<TRange, T>
+    [[nodiscard]] bool push(T&& _value)
+    {
+        return container.push_back(std::forward<T>(_value));
+    }
+
+    // returns false after the first item that was not pushed if the container reports failures
+    template <std::ranges::input_range TInputRange>
+    auto push_range(TInputRange&& range);
+
     void pop(value_type& _value);
 
+    // moves the top item out
+    value_type pop();
+
+    // moves n items from the top to out (in LIFO order)
+    template <std::output_iterator<value_type> TOutputIterator>
+    TOutputIterator pop_n(TOutputIterator out, std::size_t n);
+
+    // moves out the whole storage (the top item is at the back) and leaves the stack empty
+    TRange drain()
+    {
+        return std::exchange(container, Detail::empty_like(container));
+    }
+
     reference top()
     {
         return container.back();
     }
 };
 
+template <typename TItem, typename TRange>
+template <std::ranges::input_range TInputRange>
+auto Stack<TItem, TRange>::push_range(TInputRange&& range)
+{
+    if constexpr (std::ranges::sized_range<TInputRange> && requires(TRange& c, std::size_t n) { c.reserve(n); })
+        container.reserve(container.size() + std::ranges::size(range));
+
+    if constexpr (ReportsPushFailure<TRange, std::ranges::range_reference_t<TInputRange>>)
+    {
+        for (auto&& item : range)
+        {
+            if (!container.push_back(std::forward<decltype(item)>(item)))
+                return false;
+        }
+        return true;
+    }
+    else
+    {
+        for (auto&& item : range)
+            container.push_back(std::forward<decltype(item)>(item));
+    }
+}
+
 template <typename TItem, typename TRange>
 void Stack<TItem, TRange>::pop(value_type& _value)
 {
-    _value = container.back();
+    _value = std::move(container.back());
     container.pop_back();
 }
 
+template <typename TItem, typename TRange>
+typename Stack<TItem, TRange>::value_type Stack<TItem, TRange>::pop()
+{
+    value_type value = std::move(container.back());
+    container.pop_back();
+    return value;
+}
+
+template <typename TItem, typename TRange>
+template <std::output_iterator<typename Stack<TItem, TRange>::value_type> TOutputIterator>
+TOutputIterator Stack<TItem, TRange>::pop_n(TOutputIterator out, std::size_t n)
+{
+    for (; n > 0; --n)
+    {
+        *out++ = std::move(container.back());
+        container.pop_back();
+    }
+
+    return out;
+}
+
 namespace TemplateTemplateParam
 {
     template <
@@ -61,6 +155,13 @@ namespace TemplateTemplateParam
         using value_type = typename TContainer<TItem, TAllocator>::value_type;
         using reference = typename TContainer<TItem, TAllocator>::reference;
 
+        Stack() = default;
+
+        explicit Stack(const TAllocator& allocator)
+            : container(allocator)
+        {
+        }
+
         std::size_t size() const
         {
             return container.size();
@@ -76,18 +177,87 @@ namespace TemplateTemplateParam
             container.push_back(std::forward<T>(_value));
         }
 
+        // false if the item was not pushed (full container)
+        template <typename T>
+            requires ReportsPushFailure<container_type, T>
+        [[nodiscard]] bool push(T&& _value)
+        {
+            return container.push_back(std::forward<T>(_value));
+        }
+
+        // returns false after the first item that was not pushed if the container reports failures
+        template <std::ranges::input_range TInputRange>
+        auto push_range(TInputRange&& range);
+
         void pop(value_type& _value);
 
+        // moves the top item out
+        value_type pop();
+
+        // moves n items from the top to out (in LIFO order)
+        template <std::output_iterator<value_type> TOutputIterator>
+        TOutputIterator pop_n(TOutputIterator out, std::size_t n);
+
+        // moves out the whole storage (the top item is at the back) and leaves the stack empty
+        container_type drain()
+        {
+            return std::exchange(container, Detail::empty_like(container));
+        }
+
         reference top()
         {
             return container.back();
         }
     };
 
+    template <typename TItem, template <typename, typename> class TContainer, typename TAllocator>
+    template <std::ranges::input_range TInputRange>
+    auto Stack<TItem, TContainer, TAllocator>::push_range(TInputRange&& range)
+    {
+        if constexpr (std::ranges::sized_range<TInputRange> && requires(container_type& c, std::size_t n) { c.reserve(n); })
+            container.reserve(container.size() + std::ranges::size(range));
+
+        if constexpr (ReportsPushFailure<container_type, std::ranges::range_reference_t<TInputRange>>)
+        {
+            for (auto&& item : range)
+            {
+                if (!container.push_back(std::forward<decltype(item)>(item)))
+                    return false;
+            }
+            return true;
+        }
+        else
+        {
+            for (auto&& item : range)
+                container.push_back(std::forward<decltype(item)>(item));
+        }
+    }
+
     template <typename TItem, template <typename, typename> class TContainer, typename TAllocator>
     void Stack<TItem, TContainer, TAllocator>::pop(value_type& _value)
     {
-        _value = container.back();
+        _value = std::move(container.back());
+        container.pop_back();
+    }
+
+    template <typename TItem, template <typename, typename> class TContainer, typename TAllocator>
+    typename Stack<TItem, TContainer, TAllocator>::value_type Stack<TItem, TContainer, TAllocator>::pop()
+    {
+        value_type value = std::move(container.back());
         container.pop_back();
+        return value;
+    }
+
+    template <typename TItem, template <typename, typename> class TContainer, typename TAllocator>
+    template <std::output_iterator<typename Stack<TItem, TContainer, TAllocator>::value_type> TOutputIterator>
+    TOutputIterator Stack<TItem, TContainer, TAllocator>::pop_n(TOutputIterator out, std::size_t n)
+    {
+        for (; n > 0; --n)
+        {
+            *out++ = std::move(container.back());
+            container.pop_back();
+        }
+
+        return out;
     }
 } // namespace TemplateTemplateParam
\ No newline at end of file
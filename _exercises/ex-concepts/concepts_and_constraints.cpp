@@ -9,6 +9,8 @@
 #include <unordered_map>
 #include <vector>
 
+#include "mapped_range.hpp"
+
 using namespace std::literals;
 
 /*********************
@@ -66,6 +68,8 @@ TEST_CASE("StdContainer")
      static_assert(StdContainer<std::vector<bool>>);
      static_assert(StdContainer<std::string>);
 
+     static_assert(StdContainer<Files::MappedRange<const int>>);
+
      int arr[32];
      static_assert(!StdContainer<decltype(arr)>);
 }
@@ -138,6 +142,7 @@ TEST_CASE("IndexableStdContainer")
     static_assert(IndexableStdContainer<std::unordered_map<int, int>>);
     static_assert(IndexableStdContainer<std::vector<bool>>);
     static_assert(IndexableStdContainer<std::string>);
+    static_assert(IndexableStdContainer<Files::MappedRange<const int>>);
     static_assert(!IndexableStdContainer<int[10]>);
 }
 
@@ -0,0 +1,181 @@
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdio>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <stop_token>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace Files
+{
+    // Single-pass range of blocks of items read from a stream (pipe, stdin, file) by a background thread
+    // - while block N is processed, the next blocks are being read into the other buffers
+    // - a trailing part of the input smaller than sizeof(T) is ignored
+    // - the stream is not closed; destructor waits until the current read returns
+    template <typename T>
+        requires std::is_trivially_copyable_v<T>
+    class ChunkedInputRange
+    {
+        struct Block
+        {
+            std::unique_ptr<T[]> items;
+            std::size_t size = 0;
+        };
+
+        std::FILE* file;
+        std::size_t block_size;
+        std::vector<Block> blocks; // ring of buffers
+
+        std::mutex mtx;
+        std::condition_variable_any block_filled;
+        std::condition_variable_any block_released;
+        std::size_t filled_count = 0; // blocks read & not released yet (incl. the one being processed)
+        std::size_t read_index = 0;   // next block for the consumer
+        bool end_of_input = false;
+        std::exception_ptr error;
+
+        std::jthread reader; // the last member - started when the buffers are ready & joined first
+
+        void read_blocks(std::stop_token stop_token)
+        {
+            for (std::size_t write_index = 0;; write_index = (write_index + 1) % blocks.size())
+            {
+                {
+                    std::unique_lock lk{mtx};
+                    if (!block_released.wait(lk, stop_token, [this] { return filled_count < blocks.size(); }))
+                        return;
+                }
+
+                Block& block = blocks[write_index];
+                block.size = std::fread(block.items.get(), sizeof(T), block_size, file);
+
+                const bool last_block = block.size < block_size; // fread returns less only at the end of input or on error
+
+                {
+                    std::lock_guard lk{mtx};
+
+                    if (block.size > 0)
+                        ++filled_count;
+
+                    if (last_block)
+                    {
+                        if (std::ferror(file))
+                            error = std::make_exception_ptr(std::system_error(errno, std::generic_category(), "fread"));
+                        end_of_input = true;
+                    }
+                }
+                block_filled.notify_one();
+
+                if (last_block)
+                    return;
+            }
+        }
+
+        // the next block or nullptr at the end of input
+        const Block* acquire()
+        {
+            std::unique_lock lk{mtx};
+            block_filled.wait(lk, [this] { return filled_count > 0 || end_of_input; });
+
+            if (filled_count == 0)
+            {
+                if (error)
+                    std::rethrow_exception(error);
+                return nullptr;
+            }
+
+            return &blocks[read_index];
+        }
+
+        void release()
+        {
+            {
+                std::lock_guard lk{mtx};
+                --filled_count;
+                read_index = (read_index + 1) % blocks.size();
+            }
+            block_released.notify_one();
+        }
+
+    public:
+        static constexpr std::size_t default_block_size = std::max<std::size_t>(1, (1 << 20) / sizeof(T)); // 1 MB
+
+        class iterator
+        {
+            ChunkedInputRange* range = nullptr;
+            const Block* block = nullptr;
+
+        public:
+            using value_type = std::span<const T>;
+            using difference_type = std::ptrdiff_t;
+            using iterator_concept = std::input_iterator_tag;
+
+            iterator() = default;
+
+            explicit iterator(ChunkedInputRange& range)
+                : range{&range}
+                , block{range.acquire()}
+            {
+            }
+
+            // valid until the iterator is incremented
+            std::span<const T> operator*() const
+            {
+                return {block->items.get(), block->size};
+            }
+
+            iterator& operator++()
+            {
+                range->release();
+                block = range->acquire();
+                return *this;
+            }
+
+            void operator++(int)
+            {
+                ++*this;
+            }
+
+            friend bool operator==(const iterator& it, std::default_sentinel_t)
+            {
+                return it.block == nullptr;
+            }
+        };
+
+        // buffer_count blocks of block_size items: one is processed, the others are being read ahead
+        explicit ChunkedInputRange(std::FILE* input, std::size_t block_size = default_block_size, std::size_t buffer_count = 3)
+            : file{input}
+            , block_size{std::max<std::size_t>(1, block_size)}
+            , blocks(std::max<std::size_t>(2, buffer_count))
+        {
+            for (auto& block : blocks)
+                block.items = std::make_unique_for_overwrite<T[]>(this->block_size);
+
+            reader = std::jthread{[this](std::stop_token stop_token) { read_blocks(stop_token); }};
+        }
+
+        ChunkedInputRange(const ChunkedInputRange&) = delete;
+        ChunkedInputRange& operator=(const ChunkedInputRange&) = delete;
+
+        // single pass - begin() may be called once
+        iterator begin()
+        {
+            return iterator{*this};
+        }
+
+        std::default_sentinel_t end() const
+        {
+            return std::default_sentinel;
+        }
+    };
+} // namespace Files
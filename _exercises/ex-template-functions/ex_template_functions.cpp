@@ -1,15 +1,39 @@
 #include <algorithm>
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_approx.hpp>
 #include <catch2/catch_template_test_macros.hpp>
 #include <catch2/catch_test_macros.hpp>
+#include <climits>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
 #include <functional>
 #include <iostream>
 #include <iterator>
 #include <list>
 #include <numeric>
+#include <random>
+#include <sstream>
 #include <string>
+#include <thread>
 #include <vector>
 
+#include "chunked_input_range.hpp"
+#include "mapped_range.hpp"
+#include "parallel_accumulate.hpp"
+#include "parallel_find.hpp"
+#include "simd_find.hpp"
+#include "string_builder.hpp"
+#include "summation.hpp"
+#include "value_sentinel.hpp"
+#include "zero_strategies.hpp"
+
+#ifndef _WIN32
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 using namespace std;
 
 namespace TODO
@@ -45,16 +69,49 @@ namespace TODO
 
     inline namespace Ultimate
     {
-        template <std::input_iterator it, typename func>            
-        it find_if(it it_begin, it it_end, func check_fn)
+        template <std::input_iterator it, std::sentinel_for<it> sentinel_t, typename func>            
+        it find_if(it it_begin, sentinel_t sentinel, func check_fn)
             requires std::predicate<func, decltype(*it_begin)>
         {
-            for (it curr_it = it_begin; curr_it != it_end; ++curr_it)
+            // value sentinel over contiguous memory - locate the terminator first & search the known-length range
+            if constexpr (std::contiguous_iterator<it> && Sentinels::is_until_value<sentinel_t>)
             {
-                if (check_fn(*curr_it))
-                    return curr_it;
+                it result = it_begin;
+                Sentinels::for_each_window(it_begin, sentinel, [&](it window_begin, it window_end) {
+                    result = Ultimate::find_if(window_begin, window_end, check_fn);
+                    return result == window_end;
+                });
+                return result;
+            }
+            // comparison with a value over contiguous memory - SIMD kernel
+            else if constexpr (std::contiguous_iterator<it> && std::sized_sentinel_for<sentinel_t, it>
+                && Simd::ComparisonPredicate<func, std::iter_value_t<it>>)
+            {
+                const auto* first = std::to_address(it_begin);
+                const auto* pos = Simd::find_if(first, first + (sentinel - it_begin), check_fn);
+
+                return it_begin + (pos - first);
+            }
+            else
+            {
+                it curr_it = it_begin;
+                for (; curr_it != sentinel; ++curr_it)
+                {
+                    if (check_fn(*curr_it))
+                        return curr_it;
+                }
+                return curr_it;
             }
-            return it_end;
+        }
+
+        // parallel version - the first match; chunks after the best match found so far are not searched
+        template <std::random_access_iterator it, typename func>
+        it find_if(const Execution::ParallelPolicy& policy, it it_begin, it it_end, func check_fn)
+            requires std::predicate<func, decltype(*it_begin)>
+        {
+            return Parallel::find_first(policy, it_begin, it_end, [&check_fn](it part_begin, it part_end) {
+                return Ultimate::find_if(part_begin, part_end, check_fn);
+            });
         }
     }
 
@@ -107,6 +164,142 @@ TEMPLATE_TEST_CASE("my find if", "[vector][list]", (std::vector<int>), (std::lis
     }
 }
 
+TEMPLATE_TEST_CASE("find_if with SIMD predicates", "[find_if][simd]", int, float, double, short)
+{
+    std::vector<TestType> data(203);
+    std::iota(data.begin(), data.end(), TestType{});
+
+    SECTION("equal_to - every position incl. block boundaries & tail")
+    {
+        for (size_t i = 0; i < data.size(); ++i)
+        {
+            auto pos = TODO::find_if(data.begin(), data.end(), Simd::equal_to(static_cast<TestType>(i)));
+
+            REQUIRE(pos - data.begin() == static_cast<std::ptrdiff_t>(i));
+        }
+
+        REQUIRE(TODO::find_if(data.begin(), data.end(), Simd::equal_to(TestType{-1})) == data.end());
+    }
+
+    SECTION("less_than & greater_than")
+    {
+        std::reverse(data.begin(), data.end());
+
+        REQUIRE(*TODO::find_if(data.begin(), data.end(), Simd::less_than(TestType{100})) == 99);
+        REQUIRE(*TODO::find_if(data.begin(), data.end(), Simd::greater_than(TestType{10})) == 202);
+        REQUIRE(TODO::find_if(data.begin(), data.end(), Simd::greater_than(TestType{202})) == data.end());
+    }
+
+    SECTION("empty range")
+    {
+        std::vector<TestType> empty;
+
+        REQUIRE(TODO::find_if(empty.begin(), empty.end(), Simd::equal_to(TestType{})) == empty.end());
+    }
+}
+
+TEST_CASE("find_if in large buffer", "[.][benchmark][find_if]")
+{
+    constexpr int count = 4'000'000; // 16 MB
+    std::vector<int> data(count, 1);
+    data.back() = 665;
+
+    BENCHMARK("TODO::Ver_1::find_if - generic loop")
+    {
+        return TODO::Ver_1::find_if(data.begin(), data.end(), [](int x) { return x == 665; });
+    };
+
+    BENCHMARK("std::find_if")
+    {
+        return std::find_if(data.begin(), data.end(), [](int x) { return x == 665; });
+    };
+
+    BENCHMARK("TODO::find_if - Simd::equal_to")
+    {
+        return TODO::find_if(data.begin(), data.end(), Simd::equal_to(665));
+    };
+}
+
+TEST_CASE("parallel find_if", "[find_if]")
+{
+    std::vector<int> data(1'000'000, 0);
+
+    SECTION("the first of many matches is returned")
+    {
+        for (size_t pos : {999'999u, 500'000u, 16'385u, 16'384u, 16'383u, 0u})
+        {
+            data[pos] = 1; // matches are added from the end - each new one is the first
+
+            for (unsigned thread_count : {1u, 2u, 3u, 8u})
+            {
+                auto found = TODO::find_if(Execution::ParallelPolicy{thread_count}, data.begin(), data.end(), [](int x) { return x == 1; });
+                REQUIRE(found == data.begin() + pos);
+            }
+        }
+    }
+
+    SECTION("matches in every chunk")
+    {
+        for (size_t i = 700'000; i < data.size(); i += 1000)
+            data[i] = 1;
+
+        REQUIRE(TODO::find_if(Execution::par, data.begin(), data.end(), Simd::equal_to(1)) - data.begin() == 700'000);
+    }
+
+    SECTION("no match")
+    {
+        REQUIRE(TODO::find_if(Execution::ParallelPolicy{4}, data.begin(), data.end(), Simd::greater_than(0)) == data.end());
+    }
+
+    SECTION("empty & short ranges")
+    {
+        std::vector<int> small = {1, 2, 3};
+
+        REQUIRE(TODO::find_if(Execution::par, small.begin(), small.begin(), [](int) { return true; }) == small.begin());
+        REQUIRE(*TODO::find_if(Execution::par, small.begin(), small.end(), [](int x) { return x > 1; }) == 2);
+    }
+
+    SECTION("thread pool")
+    {
+        ThreadPool pool{4};
+        data[123'456] = 1;
+        data[654'321] = 1;
+
+        REQUIRE(TODO::find_if(Execution::ParallelPolicy{.pool = &pool}, data.begin(), data.end(), Simd::equal_to(1)) - data.begin() == 123'456);
+    }
+}
+
+TEST_CASE("parallel find_if - position of the match", "[.][benchmark][find_if]")
+{
+    constexpr size_t count = 64 * 1024 * 1024; // 256 MB
+    std::vector<int> data(count, 1);
+
+    const unsigned max_threads = std::max(1u, std::thread::hardware_concurrency());
+    ThreadPool pool{max_threads};
+
+    for (auto [position, name] : {std::pair{count / 100, "beginning"}, std::pair{count / 2, "middle"}, std::pair{count - 1, "end"}})
+    {
+        data[position] = 665;
+
+        BENCHMARK("TODO::find_if - sequential - "s + name)
+        {
+            return TODO::find_if(data.begin(), data.end(), Simd::equal_to(665));
+        };
+
+        BENCHMARK("TODO::find_if - par - "s + name)
+        {
+            return TODO::find_if(Execution::par, data.begin(), data.end(), Simd::equal_to(665));
+        };
+
+        BENCHMARK("TODO::find_if - thread pool - "s + name)
+        {
+            return TODO::find_if(Execution::ParallelPolicy{.pool = &pool}, data.begin(), data.end(), Simd::equal_to(665));
+        };
+
+        data[position] = 1;
+    }
+}
+
 namespace TODO
 {
     template <std::ranges::range TRange>
@@ -122,7 +315,7 @@ namespace TODO
         {
             T* ptr_start = std::ranges::data(range);
             size_t length = sizeof(T) * std::ranges::size(range);
-            std::memset(ptr_start, 0, length);
+            Zeroing::zero_bytes(ptr_start, length); // memset, streaming stores or many threads - depending on size
         }
         else
         {
@@ -163,22 +356,152 @@ TEST_CASE("zero")
     }
 }
 
+// restores default thresholds at the end of a test
+struct ZeroingThresholdsGuard
+{
+    Zeroing::Thresholds saved = Zeroing::thresholds;
+
+    ~ZeroingThresholdsGuard()
+    {
+        Zeroing::thresholds = saved;
+    }
+};
+
+TEST_CASE("zeroing strategies", "[zero]")
+{
+    ZeroingThresholdsGuard guard;
+
+    std::vector<std::byte> buffer(1'000'000);
+
+    auto require_zeroed = [&](size_t offset, size_t size) {
+        std::fill(buffer.begin(), buffer.end(), std::byte{0xFF});
+
+        Zeroing::zero_bytes(buffer.data() + offset, size);
+
+        REQUIRE(std::all_of(buffer.begin() + offset, buffer.begin() + offset + size, [](std::byte b) { return b == std::byte{0}; }));
+        REQUIRE(std::all_of(buffer.begin(), buffer.begin() + offset, [](std::byte b) { return b == std::byte{0xFF}; }));
+        REQUIRE(std::all_of(buffer.begin() + offset + size, buffer.end(), [](std::byte b) { return b == std::byte{0xFF}; }));
+    };
+
+    SECTION("streaming stores")
+    {
+        Zeroing::thresholds.streaming_bytes = 0;
+
+        for (size_t offset : {0, 1, 63, 100})
+            for (size_t size : {0, 1, 64, 65, 1000, 999'000})
+                require_zeroed(offset, size);
+    }
+
+    SECTION("many threads")
+    {
+        Zeroing::thresholds.streaming_bytes = 0;
+        Zeroing::thresholds.parallel_bytes = 0;
+        Zeroing::thresholds.parallel_policy = Execution::ParallelPolicy{3};
+
+        for (size_t offset : {0, 7})
+            for (size_t size : {0, 10, 4096 * 3 + 5, 999'000})
+                require_zeroed(offset, size);
+    }
+
+    SECTION("TODO::zero")
+    {
+        Zeroing::thresholds.streaming_bytes = 1024;
+        std::vector<int> vec(10'000, 42);
+
+        TODO::zero(vec);
+
+        REQUIRE(std::ranges::count(vec, 0) == 10'000);
+    }
+}
+
+TEST_CASE("zeroing strategies - buffer sizes", "[.][benchmark][zero]")
+{
+    for (size_t size = 1024; size <= 1024 * 1024 * 1024; size *= 32)
+    {
+        std::vector<std::byte> buffer(size);
+        const std::string suffix = " - " + std::to_string(size / 1024) + " KB";
+
+        BENCHMARK("memset" + suffix)
+        {
+            std::memset(buffer.data(), 0, buffer.size());
+            return buffer.data();
+        };
+
+        BENCHMARK("streaming stores" + suffix)
+        {
+            Zeroing::zero_streaming(buffer.data(), buffer.size());
+            return buffer.data();
+        };
+
+        BENCHMARK("many threads" + suffix)
+        {
+            Zeroing::zero_parallel(buffer.data(), buffer.size(), Execution::par);
+            return buffer.data();
+        };
+
+        BENCHMARK("TODO::zero" + suffix)
+        {
+            TODO::zero(buffer);
+            return buffer.data();
+        };
+    }
+}
+
 namespace TODO
 {
-    template <typename it, typename sentinel_t>
+    template <typename TSummation = Summation::Plain, typename it, typename sentinel_t>
     auto accumulate(it it_begin, sentinel_t sentinel)
     {
         // using T = typename std::iterator_traits<it>::value_type;
         using T = std::remove_cvref_t<decltype(*it_begin)>; // int
 
-        T result{};
-
-        for (; it_begin != sentinel; ++it_begin)
+        if constexpr (std::contiguous_iterator<it> && Sentinels::is_until_value<sentinel_t>)
+        {
+            // dense loops over known-length windows
+            if constexpr (std::is_same_v<TSummation, Summation::Plain>)
+            {
+                T result{};
+                Sentinels::for_each_window(it_begin, sentinel, [&result](it window_begin, it window_end) {
+                    result += accumulate(window_begin, window_end);
+                    return true;
+                });
+                return result;
+            }
+            else
+            {
+                // other policies see the whole range at once
+                return accumulate<TSummation>(it_begin, Sentinels::find_end(it_begin, sentinel));
+            }
+        }
+        else if constexpr (!std::is_same_v<TSummation, Summation::Plain>)
         {
-            result += *it_begin;
+            return TSummation::template sum<T>(it_begin, sentinel);
         }
+        else if constexpr (Strings::is_basic_string<T> && std::sentinel_for<sentinel_t, it>)
+        {
+            // sentinels that do not model sentinel_for (e.g. non-const operator==) use the generic loop
+            return Strings::concat<T>(it_begin, sentinel);
+        }
+        else
+        {
+            T result{};
 
-        return result;
+            for (; it_begin != sentinel; ++it_begin)
+            {
+                result += *it_begin;
+            }
+
+            return result;
+        }
+    }
+
+    // deterministic parallel version - partial sums of fixed-size chunks are combined in order
+    template <std::random_access_iterator it>
+    auto accumulate(const Execution::ParallelPolicy& policy, it it_begin, it it_end)
+    {
+        using T = std::remove_cvref_t<decltype(*it_begin)>;
+
+        return Parallel::accumulate<T>(policy, it_begin, it_end);
     }
 } // namespace TODO
 
@@ -207,6 +530,274 @@ TEST_CASE("my accumulate")
     }
 }
 
+namespace
+{
+    // values of very different magnitudes - plain float summation loses most of the small ones
+    std::vector<float> make_ill_conditioned_data(size_t count)
+    {
+        std::mt19937 rnd{665};
+        std::uniform_real_distribution<float> values{0.0f, 1.0f};
+
+        std::vector<float> data(count);
+        for (auto& item : data)
+            item = values(rnd);
+        data[0] = 1.0e6f;
+
+        return data;
+    }
+
+    long double reference_sum(const std::vector<float>& data)
+    {
+        long double sum = 0.0L;
+        for (float item : data)
+            sum += item;
+        return sum;
+    }
+
+    long double relative_error(long double result, long double reference)
+    {
+        return std::abs((result - reference) / reference);
+    }
+} // namespace
+
+TEST_CASE("accumulate strings", "[accumulate]")
+{
+    const std::vector<std::string> words = {"one", "two", "", "three"};
+
+    SECTION("multi-pass range")
+    {
+        std::list<std::string> lst(words.begin(), words.end());
+
+        REQUIRE(TODO::accumulate(lst.begin(), lst.end()) == "onetwothree");
+    }
+
+    SECTION("single-pass range")
+    {
+        std::istringstream input{"one two three"};
+
+        auto result = TODO::accumulate(std::istream_iterator<std::string>{input}, std::istream_iterator<std::string>{});
+
+        REQUIRE(result == "onetwothree");
+    }
+
+    SECTION("StringBuilder spanning many chunks")
+    {
+        Strings::StringBuilder<std::string> builder;
+        std::string expected;
+
+        for (int i = 0; i < 1000; ++i)
+        {
+            const std::string text(i % 7, 'a' + i % 26);
+            builder.append(text);
+            expected += text;
+        }
+
+        REQUIRE(builder.size() == expected.size());
+        REQUIRE(builder.str() == expected);
+    }
+}
+
+TEST_CASE("accumulate strings - join 10^6 short strings", "[.][benchmark][accumulate]")
+{
+    std::vector<std::string> words(1'000'000);
+    std::string text;
+    for (size_t i = 0; i < words.size(); ++i)
+    {
+        words[i] = std::to_string(i % 1000);
+        text += words[i] + ' ';
+    }
+
+    auto naive_concat = [](auto first, auto last) {
+        std::string result;
+        for (; first != last; ++first)
+            result += *first;
+        return result;
+    };
+
+    BENCHMARK("vector - result += item")
+    {
+        return naive_concat(words.begin(), words.end());
+    };
+
+    BENCHMARK("vector - TODO::accumulate (reserve & append)")
+    {
+        return TODO::accumulate(words.begin(), words.end());
+    };
+
+    BENCHMARK("istream_iterator - result += item")
+    {
+        std::istringstream input{text};
+        return naive_concat(std::istream_iterator<std::string>{input}, std::istream_iterator<std::string>{});
+    };
+
+    BENCHMARK("istream_iterator - TODO::accumulate (StringBuilder)")
+    {
+        std::istringstream input{text};
+        return TODO::accumulate(std::istream_iterator<std::string>{input}, std::istream_iterator<std::string>{});
+    };
+}
+
+TEST_CASE("accumulate with summation policies", "[accumulate]")
+{
+    SECTION("Widened - ints do not overflow")
+    {
+        const std::vector<int> data(4, INT_MAX);
+
+        auto result = TODO::accumulate<Summation::Widened>(data.begin(), data.end());
+
+        static_assert(std::is_same_v<decltype(result), std::int64_t>);
+        REQUIRE(result == 4LL * INT_MAX);
+    }
+
+    SECTION("Plain is the default")
+    {
+        const std::vector<int> data = {1, 2, 3, 4, 5};
+
+        REQUIRE(TODO::accumulate<Summation::Plain>(data.begin(), data.end()) == TODO::accumulate(data.begin(), data.end()));
+    }
+
+    SECTION("input iterators")
+    {
+        std::list<double> data = {0.5, 1.5, 2.0};
+
+        REQUIRE(TODO::accumulate<Summation::Kahan>(data.begin(), data.end()) == 4.0);
+        REQUIRE(TODO::accumulate<Summation::Widened>(data.begin(), data.end()) == 4.0L);
+    }
+
+    SECTION("strings keep their order")
+    {
+        std::vector<std::string> digits;
+        for (int i = 0; i < 300; ++i)
+            digits.push_back(std::to_string(i % 10));
+
+        const std::string expected = TODO::accumulate(digits.begin(), digits.end());
+
+        REQUIRE(expected.starts_with("0123456789"));
+        REQUIRE(TODO::accumulate<Summation::Widened>(digits.begin(), digits.end()) == expected);
+        REQUIRE(TODO::accumulate<Summation::Pairwise>(digits.begin(), digits.end()) == expected);
+    }
+
+    SECTION("compensated & pairwise summation are more accurate than plain float summation")
+    {
+        const auto data = make_ill_conditioned_data(1'000'003);
+        const long double reference = reference_sum(data);
+
+        const auto plain_error = relative_error(TODO::accumulate(data.begin(), data.end()), reference);
+        const auto kahan_error = relative_error(TODO::accumulate<Summation::Kahan>(data.begin(), data.end()), reference);
+        const auto pairwise_error = relative_error(TODO::accumulate<Summation::Pairwise>(data.begin(), data.end()), reference);
+        const auto widened_error = relative_error(TODO::accumulate<Summation::Widened>(data.begin(), data.end()), reference);
+
+        INFO("plain: " << plain_error << ", kahan: " << kahan_error << ", pairwise: " << pairwise_error << ", widened: " << widened_error);
+        REQUIRE(plain_error > 1.0e-5L);
+        REQUIRE(kahan_error < 1.0e-7L);
+        REQUIRE(pairwise_error < 1.0e-6L);
+        REQUIRE(widened_error < 1.0e-7L);
+        REQUIRE(kahan_error < plain_error / 100);
+    }
+}
+
+TEST_CASE("accumulate with summation policies - throughput & error", "[.][benchmark][accumulate]")
+{
+    const auto data = make_ill_conditioned_data(10'000'000);
+    const long double reference = reference_sum(data);
+
+    auto report_error = [reference](const std::string& name, long double result) {
+        std::cout << name << " - relative error: " << relative_error(result, reference) << "\n";
+    };
+
+    report_error("Plain", TODO::accumulate(data.begin(), data.end()));
+    report_error("Widened", TODO::accumulate<Summation::Widened>(data.begin(), data.end()));
+    report_error("Kahan", TODO::accumulate<Summation::Kahan>(data.begin(), data.end()));
+    report_error("Pairwise", TODO::accumulate<Summation::Pairwise>(data.begin(), data.end()));
+
+    BENCHMARK("Plain")
+    {
+        return TODO::accumulate(data.begin(), data.end());
+    };
+
+    BENCHMARK("Widened")
+    {
+        return TODO::accumulate<Summation::Widened>(data.begin(), data.end());
+    };
+
+    BENCHMARK("Kahan")
+    {
+        return TODO::accumulate<Summation::Kahan>(data.begin(), data.end());
+    };
+
+    BENCHMARK("Pairwise")
+    {
+        return TODO::accumulate<Summation::Pairwise>(data.begin(), data.end());
+    };
+
+    BENCHMARK("long double reference")
+    {
+        return reference_sum(data);
+    };
+}
+
+TEST_CASE("parallel accumulate", "[accumulate]")
+{
+    SECTION("ints")
+    {
+        std::vector<int> data(100'000);
+        std::iota(data.begin(), data.end(), 0);
+
+        REQUIRE(TODO::accumulate(Execution::par, data.begin(), data.end()) == std::accumulate(data.begin(), data.end(), 0));
+    }
+
+    SECTION("strings - order of items is preserved")
+    {
+        std::vector<std::string> words(5'000);
+        for (size_t i = 0; i < words.size(); ++i)
+            words[i] = std::to_string(i % 10);
+
+        REQUIRE(TODO::accumulate(Execution::ParallelPolicy{3}, words.begin(), words.end()) == TODO::accumulate(words.begin(), words.end()));
+    }
+
+    SECTION("doubles - result does not depend on number of threads")
+    {
+        std::vector<double> data(1'000'000);
+        for (size_t i = 0; i < data.size(); ++i)
+            data[i] = 1.0 / (i + 1);
+
+        const double result = TODO::accumulate(Execution::ParallelPolicy{1}, data.begin(), data.end());
+
+        for (unsigned thread_count : {2u, 3u, 8u})
+            REQUIRE(TODO::accumulate(Execution::ParallelPolicy{thread_count}, data.begin(), data.end()) == result);
+
+        REQUIRE(result == Catch::Approx(std::accumulate(data.begin(), data.end(), 0.0)));
+    }
+
+    SECTION("empty range")
+    {
+        std::vector<double> empty;
+
+        REQUIRE(TODO::accumulate(Execution::par, empty.begin(), empty.end()) == 0.0);
+    }
+}
+
+TEST_CASE("parallel accumulate - scaling", "[.][benchmark][accumulate]")
+{
+    std::vector<double> data(20'000'000);
+    std::iota(data.begin(), data.end(), 0.0);
+
+    BENCHMARK("TODO::accumulate - sequential")
+    {
+        return TODO::accumulate(data.begin(), data.end());
+    };
+
+    const unsigned max_threads = std::max(1u, std::thread::hardware_concurrency());
+
+    for (unsigned thread_count = 1; thread_count <= max_threads; ++thread_count)
+    {
+        BENCHMARK("TODO::accumulate - par - " + std::to_string(thread_count) + " threads")
+        {
+            return TODO::accumulate(Execution::ParallelPolicy{thread_count}, data.begin(), data.end());
+        };
+    }
+}
+
 struct EndValue42
 {
     bool operator==(auto it)
@@ -215,10 +806,435 @@ struct EndValue42
     }
 };
 
+struct EndEmptyString
+{
+    bool operator==(auto it)
+    {
+        return it->empty();
+    }
+};
+
 TEST_CASE("sentinels")
 {
     std::vector<int> vec = {1, 2, 3, 4, 5, 42, 6, 7, 8, 9};
 
     auto result = TODO::accumulate(vec.begin(), EndValue42{});
     REQUIRE(result== 15);
-}
\ No newline at end of file
+
+    SECTION("strings")
+    {
+        std::vector<std::string> words = {"one", "two", "", "three"};
+
+        static_assert(!std::sentinel_for<EndEmptyString, std::vector<std::string>::iterator>);
+        REQUIRE(TODO::accumulate(words.begin(), EndEmptyString{}) == "onetwo");
+    }
+}
+
+TEST_CASE("value sentinels", "[sentinels]")
+{
+    using Sentinels::until_value;
+
+    std::vector<int> vec(1000);
+    std::iota(vec.begin(), vec.end(), 1);
+
+    SECTION("accumulate")
+    {
+        for (int terminator : {1, 2, 42, 500, 1000})
+        {
+            vec[terminator - 1] = -1;
+
+            auto result = TODO::accumulate(vec.begin(), until_value<-1>{});
+
+            REQUIRE(result == terminator * (terminator - 1) / 2);
+
+            vec[terminator - 1] = terminator;
+        }
+    }
+
+    SECTION("accumulate - all misaligned starting points")
+    {
+        vec[900] = -1;
+
+        for (int start = 0; start < 40; ++start)
+            REQUIRE(TODO::accumulate(vec.begin() + start, until_value<-1>{}) == std::accumulate(vec.begin() + start, vec.begin() + 900, 0));
+    }
+
+    SECTION("find_if")
+    {
+        vec[500] = 0;
+
+        auto pos = TODO::find_if(vec.begin(), until_value<0>{}, [](int x) { return x % 100 == 0; });
+        REQUIRE(*pos == 100);
+
+        pos = TODO::find_if(vec.begin(), until_value<0>{}, Simd::greater_than(1000));
+        REQUIRE(pos == vec.begin() + 500);
+    }
+
+    SECTION("range spanning many windows")
+    {
+        std::vector<int> data(20'000, 1);
+        data[15'003] = 0;
+        data[9'001] = 2;
+
+        REQUIRE(TODO::accumulate(data.begin(), until_value<0>{}) == 15'004);
+        REQUIRE(TODO::find_if(data.begin(), until_value<0>{}, Simd::greater_than(1)) == data.begin() + 9'001);
+        REQUIRE(TODO::find_if(data.begin(), until_value<0>{}, Simd::greater_than(2)) == data.begin() + 15'003);
+    }
+
+    SECTION("non-contiguous range")
+    {
+        std::list<int> lst = {1, 2, 3, 0, 4};
+
+        REQUIRE(TODO::accumulate(lst.begin(), until_value<0>{}) == 6);
+    }
+
+    SECTION("floats")
+    {
+        std::vector<float> data = {1.0f, 2.0f, 0.5f, -1.0f, 4.0f};
+
+        REQUIRE(TODO::accumulate(data.begin(), until_value<-1.0f>{}) == 3.5f);
+    }
+}
+
+struct EndValue0
+{
+    bool operator==(auto it) const
+    {
+        return *it == 0;
+    }
+};
+
+TEST_CASE("value sentinels - terminated records", "[.][benchmark][sentinels]")
+{
+    for (size_t size : {32'000, 4'000'000}) // in cache & memory-bound
+    {
+        std::vector<int> data(size, 1);
+        data.back() = 0;
+
+        const std::string suffix = " - " + std::to_string(size) + " items";
+
+        BENCHMARK("accumulate - sentinel checked per item" + suffix)
+        {
+            return TODO::accumulate(data.begin(), EndValue0{});
+        };
+
+        BENCHMARK("accumulate - until_value<0>" + suffix)
+        {
+            return TODO::accumulate(data.begin(), Sentinels::until_value<0>{});
+        };
+
+        BENCHMARK("find_if - sentinel checked per item" + suffix)
+        {
+            return TODO::find_if(data.begin(), EndValue0{}, Simd::greater_than(1));
+        };
+
+        BENCHMARK("find_if - until_value<0>" + suffix)
+        {
+            return TODO::find_if(data.begin(), Sentinels::until_value<0>{}, Simd::greater_than(1));
+        };
+    }
+}
+
+// file in the temp directory removed at the end of the test
+struct TemporaryFile
+{
+    std::filesystem::path path;
+
+    explicit TemporaryFile(const std::string& name)
+        : path{std::filesystem::temp_directory_path() / name}
+    {
+    }
+
+    ~TemporaryFile()
+    {
+        std::error_code ec;
+        std::filesystem::remove(path, ec);
+    }
+};
+
+TEST_CASE("memory-mapped files", "[mapped_range]")
+{
+    using Files::MappedRange;
+
+    static_assert(std::ranges::contiguous_range<MappedRange<const int>>);
+    static_assert(std::ranges::sized_range<MappedRange<const int>>);
+
+    TemporaryFile file{"ex_template_functions_mapped_range.bin"};
+
+    {
+        auto output = MappedRange<int>::create(file.path, 100'000);
+        REQUIRE(output.size() == 100'000);
+
+        std::iota(output.begin(), output.end(), 1);
+        output.flush();
+    }
+
+    REQUIRE(std::filesystem::file_size(file.path) == 100'000 * sizeof(int));
+
+    SECTION("read-only mapping works with the range algorithms")
+    {
+        const MappedRange<const int> input{file.path};
+
+        REQUIRE(input.advise(Files::AccessHint::sequential));
+        REQUIRE(TODO::accumulate<Summation::Widened>(input.begin(), input.end()) == 100'000LL * 100'001 / 2);
+        REQUIRE(*TODO::find_if(input.begin(), input.end(), Simd::greater_than(99'998)) == 99'999);
+        REQUIRE(TODO::find_if(Execution::ParallelPolicy{4}, input.begin(), input.end(), [](int x) { return x % 40'000 == 0; }) - input.begin() == 39'999);
+    }
+
+    SECTION("read-write mapping - changes are written to the file")
+    {
+        {
+            MappedRange<int> data{file.path};
+            data[0] = -1;
+            TODO::zero(data);
+        }
+
+        const MappedRange<const int> input{file.path};
+        REQUIRE(std::all_of(input.begin(), input.end(), [](int x) { return x == 0; }));
+    }
+
+    SECTION("move")
+    {
+        MappedRange<const int> input{file.path};
+        MappedRange<const int> target = std::move(input);
+
+        REQUIRE(input.empty());
+        REQUIRE(target[99'999] == 100'000);
+    }
+
+    SECTION("empty file")
+    {
+        std::filesystem::resize_file(file.path, 0);
+
+        const MappedRange<const int> input{file.path};
+        REQUIRE(input.empty());
+        REQUIRE(input.begin() == input.end());
+        REQUIRE_FALSE(input.advise(Files::AccessHint::will_need));
+    }
+
+    SECTION("missing file")
+    {
+        REQUIRE_THROWS_AS(MappedRange<const int>{file.path.string() + ".missing"}, std::system_error);
+    }
+}
+
+TEST_CASE("memory-mapped files - time to first result for 1 GB file", "[.][benchmark][mapped_range]")
+{
+    constexpr size_t count = 256 * 1024 * 1024; // 1 GB of ints
+    constexpr size_t first_match = 256 * 1024;  // 1 MB from the beginning
+
+    TemporaryFile file{"ex_template_functions_mapped_range_1GB.bin"};
+    {
+        auto output = Files::MappedRange<int>::create(file.path, count);
+        std::fill(output.begin(), output.end(), 1);
+        output[first_match] = 665;
+    }
+
+    auto read_into_vector = [&file] {
+        std::vector<int> data(std::filesystem::file_size(file.path) / sizeof(int));
+        std::ifstream input{file.path, std::ios::binary};
+        input.read(reinterpret_cast<char*>(data.data()), data.size() * sizeof(int));
+        return data;
+    };
+
+    // files are in page cache after the first sample - the difference is copying vs mapping of pages
+    BENCHMARK("read into vector - find_if")
+    {
+        const auto data = read_into_vector();
+        return TODO::find_if(data.begin(), data.end(), Simd::equal_to(665)) - data.begin();
+    };
+
+    BENCHMARK("MappedRange - find_if")
+    {
+        const Files::MappedRange<const int> data{file.path};
+        return TODO::find_if(data.begin(), data.end(), Simd::equal_to(665)) - data.begin();
+    };
+
+    BENCHMARK("read into vector - accumulate")
+    {
+        const auto data = read_into_vector();
+        return TODO::accumulate(data.begin(), data.end());
+    };
+
+    BENCHMARK("MappedRange - accumulate")
+    {
+        const Files::MappedRange<const int> data{file.path};
+        return TODO::accumulate(data.begin(), data.end());
+    };
+
+    BENCHMARK("MappedRange - accumulate - sequential & huge pages hints")
+    {
+        const Files::MappedRange<const int> data{file.path};
+        data.advise(Files::AccessHint::sequential);
+        data.advise(Files::AccessHint::huge_pages);
+        return TODO::accumulate(data.begin(), data.end());
+    };
+}
+
+TEST_CASE("chunked input with read-ahead", "[chunked_input]")
+{
+    using Files::ChunkedInputRange;
+
+    static_assert(std::ranges::input_range<ChunkedInputRange<int>>);
+
+    std::vector<int> data(10'500);
+    std::iota(data.begin(), data.end(), 1);
+
+    TemporaryFile file{"ex_template_functions_chunked_input.bin"};
+    {
+        std::ofstream output{file.path, std::ios::binary};
+        output.write(reinterpret_cast<const char*>(data.data()), data.size() * sizeof(int));
+    }
+
+    std::unique_ptr<std::FILE, decltype(&std::fclose)> input{std::fopen(file.path.string().c_str(), "rb"), &std::fclose};
+    REQUIRE(input);
+
+    SECTION("blocks are read in order - the last one is partial")
+    {
+        std::vector<int> items;
+        std::vector<size_t> block_sizes;
+
+        for (std::span<const int> block : ChunkedInputRange<int>{input.get(), 1000})
+        {
+            items.insert(items.end(), block.begin(), block.end());
+            block_sizes.push_back(block.size());
+        }
+
+        REQUIRE(items == data);
+        REQUIRE(block_sizes.size() == 11);
+        REQUIRE(block_sizes.back() == 500);
+    }
+
+    SECTION("accumulate & find_if process blocks")
+    {
+        long long total = 0;
+        std::ptrdiff_t offset = 0, found = -1;
+
+        for (std::span<const int> block : ChunkedInputRange<int>{input.get(), 256, 2})
+        {
+            total += TODO::accumulate<Summation::Widened>(block.begin(), block.end());
+
+            if (auto pos = TODO::find_if(block.begin(), block.end(), Simd::greater_than(7'000)); found < 0 && pos != block.end())
+                found = offset + (pos - block.begin());
+            offset += block.size();
+        }
+
+        REQUIRE(total == 10'500LL * 10'501 / 2);
+        REQUIRE(found == 7'000);
+    }
+
+    SECTION("stop before the end of input")
+    {
+        ChunkedInputRange<int> chunks{input.get(), 100};
+        auto it = chunks.begin();
+        REQUIRE((*it)[0] == 1);
+        ++it;
+        REQUIRE((*it)[0] == 101);
+    }
+
+    SECTION("empty input")
+    {
+        std::unique_ptr<std::FILE, decltype(&std::fclose)> empty{std::tmpfile(), &std::fclose};
+        ChunkedInputRange<int> chunks{empty.get()};
+
+        REQUIRE(chunks.begin() == chunks.end());
+    }
+
+#ifndef _WIN32
+    SECTION("pipe")
+    {
+        int fds[2];
+        REQUIRE(::pipe(fds) == 0);
+
+        std::jthread writer{[&data, fd = fds[1]] {
+            const char* bytes = reinterpret_cast<const char*>(data.data());
+            for (size_t left = data.size() * sizeof(int); left > 0;)
+            {
+                const ssize_t written = ::write(fd, bytes, std::min<size_t>(left, 777)); // items split between writes
+                bytes += written;
+                left -= written;
+            }
+            ::close(fd);
+        }};
+
+        std::unique_ptr<std::FILE, decltype(&std::fclose)> pipe_input{::fdopen(fds[0], "rb"), &std::fclose};
+
+        long long total = 0;
+        for (std::span<const int> block : ChunkedInputRange<int>{pipe_input.get(), 1024})
+            total += TODO::accumulate<Summation::Widened>(block.begin(), block.end());
+
+        REQUIRE(total == 10'500LL * 10'501 / 2);
+    }
+#endif
+}
+
+TEST_CASE("chunked input with read-ahead - throughput", "[.][benchmark][chunked_input]")
+{
+    constexpr size_t count = 64 * 1024 * 1024; // 256 MB of floats
+    std::vector<float> data(count, 0.5f);
+
+    TemporaryFile file{"ex_template_functions_chunked_input_256MB.bin"};
+    {
+        std::ofstream output{file.path, std::ios::binary};
+        output.write(reinterpret_cast<const char*>(data.data()), data.size() * sizeof(float));
+    }
+
+    // compensated summation - enough work per block to overlap with reading
+    auto process = [](std::span<const float> block) { return TODO::accumulate<Summation::Kahan>(block.begin(), block.end()); };
+
+    auto read_then_process = [&process](std::FILE* input) {
+        std::vector<float> buffer(Files::ChunkedInputRange<float>::default_block_size);
+        double total = 0.0;
+        while (size_t size = std::fread(buffer.data(), sizeof(float), buffer.size(), input))
+            total += process(std::span{buffer.data(), size});
+        return total;
+    };
+
+    auto read_ahead = [&process](std::FILE* input) {
+        double total = 0.0;
+        for (std::span<const float> block : Files::ChunkedInputRange<float>{input})
+            total += process(block);
+        return total;
+    };
+
+    auto from_file = [&file](auto consume) {
+        std::unique_ptr<std::FILE, decltype(&std::fclose)> input{std::fopen(file.path.string().c_str(), "rb"), &std::fclose};
+        return consume(input.get());
+    };
+
+    BENCHMARK("file - fread & process in one thread")
+    {
+        return from_file(read_then_process);
+    };
+
+    BENCHMARK("file - ChunkedInputRange")
+    {
+        return from_file(read_ahead);
+    };
+
+#ifndef _WIN32
+    TemporaryFile fifo{"ex_template_functions_chunked_input.fifo"};
+    REQUIRE(::mkfifo(fifo.path.c_str(), 0600) == 0);
+
+    // the writer produces data from memory as fast as the pipe accepts it
+    auto from_fifo = [&](auto consume) {
+        std::jthread writer{[&] {
+            std::unique_ptr<std::FILE, decltype(&std::fclose)> output{std::fopen(fifo.path.c_str(), "wb"), &std::fclose};
+            std::fwrite(data.data(), sizeof(float), data.size(), output.get());
+        }};
+
+        std::unique_ptr<std::FILE, decltype(&std::fclose)> input{std::fopen(fifo.path.c_str(), "rb"), &std::fclose};
+        return consume(input.get());
+    };
+
+    BENCHMARK("FIFO - fread & process in one thread")
+    {
+        return from_fifo(read_then_process);
+    };
+
+    BENCHMARK("FIFO - ChunkedInputRange")
+    {
+        return from_fifo(read_ahead);
+    };
+#endif
+}
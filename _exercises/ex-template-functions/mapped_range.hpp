@@ -0,0 +1,293 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Files
+{
+    enum class AccessHint
+    {
+        normal,
+        sequential, // aggressive read-ahead, pages behind the reader can be dropped
+        random,     // no read-ahead
+        will_need,  // start reading the pages in the background
+        huge_pages  // back the mapping with transparent huge pages (fewer TLB misses) - if supported for files
+    };
+
+    // Items of a file mapped into memory - pages are read on first access instead of copying the whole file up front
+    // - MappedRange<const T> maps the file read-only, MappedRange<T> read-write (writes go to the file)
+    template <typename T>
+        requires std::is_trivially_copyable_v<T>
+    class MappedRange
+    {
+        static constexpr bool writable = !std::is_const_v<T>;
+        static constexpr std::size_t no_resize = static_cast<std::size_t>(-1);
+
+        T* items = nullptr;
+        std::size_t count = 0;
+#ifdef _WIN32
+        HANDLE file = INVALID_HANDLE_VALUE;
+        HANDLE mapping = nullptr;
+#endif
+
+        [[noreturn]] static void throw_last_error(const char* what)
+        {
+#ifdef _WIN32
+            throw std::system_error(static_cast<int>(GetLastError()), std::system_category(), what);
+#else
+            throw std::system_error(errno, std::generic_category(), what);
+#endif
+        }
+
+        void map(const std::filesystem::path& path, std::size_t new_size)
+        {
+#ifdef _WIN32
+            file = CreateFileW(path.c_str(), writable ? GENERIC_READ | GENERIC_WRITE : GENERIC_READ, FILE_SHARE_READ, nullptr,
+                new_size != no_resize ? CREATE_ALWAYS : OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+            if (file == INVALID_HANDLE_VALUE)
+                throw_last_error("CreateFileW");
+
+            LARGE_INTEGER file_size;
+            if (new_size != no_resize)
+                file_size.QuadPart = static_cast<LONGLONG>(new_size * sizeof(T));
+            else if (!GetFileSizeEx(file, &file_size))
+                throw_last_error("GetFileSizeEx");
+
+            count = static_cast<std::size_t>(file_size.QuadPart) / sizeof(T);
+            if (count == 0)
+                return;
+
+            mapping = CreateFileMappingW(file, nullptr, writable ? PAGE_READWRITE : PAGE_READONLY, file_size.HighPart, file_size.LowPart, nullptr);
+            if (!mapping)
+                throw_last_error("CreateFileMappingW");
+
+            void* address = MapViewOfFile(mapping, writable ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, count * sizeof(T));
+            if (!address)
+                throw_last_error("MapViewOfFile");
+#else
+            const int fd = ::open(path.c_str(), writable ? O_RDWR | (new_size != no_resize ? O_CREAT | O_TRUNC : 0) : O_RDONLY, 0644);
+            if (fd == -1)
+                throw_last_error("open");
+
+            // the descriptor may be closed right after mmap - the mapping keeps its own reference to the file
+            struct FileDescriptor
+            {
+                int fd;
+                ~FileDescriptor() { ::close(fd); }
+            } closer{fd};
+
+            if (new_size != no_resize && ::ftruncate(fd, static_cast<off_t>(new_size * sizeof(T))) == -1)
+                throw_last_error("ftruncate");
+
+            struct stat info;
+            if (::fstat(fd, &info) == -1)
+                throw_last_error("fstat");
+
+            count = static_cast<std::size_t>(info.st_size) / sizeof(T);
+            if (count == 0)
+                return;
+
+            void* address = ::mmap(nullptr, count * sizeof(T), writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, fd, 0);
+            if (address == MAP_FAILED)
+                throw_last_error("mmap");
+#endif
+            items = static_cast<T*>(address);
+        }
+
+        void unmap() noexcept
+        {
+#ifdef _WIN32
+            if (items)
+                UnmapViewOfFile(items);
+            if (mapping)
+                CloseHandle(mapping);
+            if (file != INVALID_HANDLE_VALUE)
+                CloseHandle(file);
+            mapping = nullptr;
+            file = INVALID_HANDLE_VALUE;
+#else
+            if (items)
+                ::munmap(const_cast<std::remove_const_t<T>*>(items), count * sizeof(T));
+#endif
+            items = nullptr;
+            count = 0;
+        }
+
+        MappedRange(const std::filesystem::path& path, std::size_t new_size)
+        {
+            try
+            {
+                map(path, new_size);
+            }
+            catch (...)
+            {
+                unmap();
+                throw;
+            }
+        }
+
+    public:
+        using value_type = std::remove_cv_t<T>;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using reference = T&;
+        using const_reference = const T&;
+        using iterator = T*;
+        using const_iterator = const T*;
+
+        MappedRange() = default;
+
+        // maps the whole file (a trailing part smaller than sizeof(T) is ignored)
+        explicit MappedRange(const std::filesystem::path& path)
+            : MappedRange(path, no_resize)
+        {
+        }
+
+        // creates (or truncates) a file of size items & maps it read-write
+        static MappedRange create(const std::filesystem::path& path, std::size_t size)
+            requires writable
+        {
+            return MappedRange(path, size);
+        }
+
+        MappedRange(const MappedRange&) = delete;
+        MappedRange& operator=(const MappedRange&) = delete;
+
+        MappedRange(MappedRange&& other) noexcept
+            : items{std::exchange(other.items, nullptr)}
+            , count{std::exchange(other.count, 0)}
+#ifdef _WIN32
+            , file{std::exchange(other.file, INVALID_HANDLE_VALUE)}
+            , mapping{std::exchange(other.mapping, nullptr)}
+#endif
+        {
+        }
+
+        MappedRange& operator=(MappedRange&& other) noexcept
+        {
+            if (this != &other)
+            {
+                unmap();
+                items = std::exchange(other.items, nullptr);
+                count = std::exchange(other.count, 0);
+#ifdef _WIN32
+                file = std::exchange(other.file, INVALID_HANDLE_VALUE);
+                mapping = std::exchange(other.mapping, nullptr);
+#endif
+            }
+            return *this;
+        }
+
+        ~MappedRange()
+        {
+            unmap();
+        }
+
+        T* data() const noexcept
+        {
+            return items;
+        }
+
+        std::size_t size() const noexcept
+        {
+            return count;
+        }
+
+        bool empty() const noexcept
+        {
+            return count == 0;
+        }
+
+        iterator begin() const noexcept
+        {
+            return items;
+        }
+
+        iterator end() const noexcept
+        {
+            return items + count;
+        }
+
+        T& operator[](std::size_t index) const noexcept
+        {
+            return items[index];
+        }
+
+        // hint for the kernel how the items [offset; offset + length) will be accessed;
+        // returns false when the hint is not supported - the mapping works the same, only slower
+        bool advise(AccessHint hint, std::size_t offset = 0, std::size_t length = no_resize) const noexcept
+        {
+            if (empty() || offset >= count)
+                return false;
+
+            length = std::min(length, count - offset);
+
+#ifdef _WIN32
+            if (hint != AccessHint::will_need)
+                return false;
+
+            WIN32_MEMORY_RANGE_ENTRY range{const_cast<std::remove_const_t<T>*>(items + offset), length * sizeof(T)};
+            return PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+#else
+            // madvise requires a page-aligned address
+            const std::size_t page_size = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+            const auto first = reinterpret_cast<std::uintptr_t>(items + offset);
+            const auto aligned_first = first & ~(page_size - 1);
+            void* address = reinterpret_cast<void*>(aligned_first);
+            const std::size_t bytes = first - aligned_first + length * sizeof(T);
+
+            switch (hint)
+            {
+            case AccessHint::normal:
+                return ::madvise(address, bytes, MADV_NORMAL) == 0;
+            case AccessHint::sequential:
+                return ::madvise(address, bytes, MADV_SEQUENTIAL) == 0;
+            case AccessHint::random:
+                return ::madvise(address, bytes, MADV_RANDOM) == 0;
+            case AccessHint::will_need:
+                return ::madvise(address, bytes, MADV_WILLNEED) == 0;
+            case AccessHint::huge_pages:
+#ifdef MADV_HUGEPAGE
+                return ::madvise(address, bytes, MADV_HUGEPAGE) == 0;
+#else
+                return false;
+#endif
+            }
+            return false;
+#endif
+        }
+
+        // writes modified pages to the file before returning
+        void flush() const
+            requires writable
+        {
+            if (empty())
+                return;
+#ifdef _WIN32
+            if (!FlushViewOfFile(items, count * sizeof(T)) || !FlushFileBuffers(file))
+                throw_last_error("FlushViewOfFile");
+#else
+            if (::msync(items, count * sizeof(T), MS_SYNC) == -1)
+                throw_last_error("msync");
+#endif
+        }
+    };
+} // namespace Files
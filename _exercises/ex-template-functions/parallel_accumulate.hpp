@@ -0,0 +1,141 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <mutex>
+#include <ranges>
+#include <thread>
+#include <vector>
+
+#include "thread_pool.hpp"
+
+namespace Execution
+{
+    struct ParallelPolicy
+    {
+        unsigned thread_count = 0; // 0 - std::thread::hardware_concurrency()
+        ThreadPool* pool = nullptr;  // tasks are executed in the pool instead of new threads (thread_count is ignored)
+
+        unsigned threads() const
+        {
+            if (pool)
+                return pool->size();
+            return thread_count ? thread_count : std::max(1u, std::thread::hardware_concurrency());
+        }
+    };
+
+    inline constexpr ParallelPolicy par{};
+} // namespace Execution
+
+namespace Parallel
+{
+    // chunks fit in L1 cache; the size does not depend on the number of threads,
+    // so the same partial sums are combined in the same order on every machine
+    template <typename T>
+    constexpr std::size_t chunk_size = std::max<std::size_t>(1024, 32 * 1024 / sizeof(T));
+
+    // 4 accumulators walk 4 consecutive parts of the chunk in lockstep - independent dependency chains
+    // (parts are combined in order, so only associativity of += is required)
+    template <typename T, std::random_access_iterator TIterator>
+    T accumulate_chunk(TIterator first, TIterator last)
+    {
+        const auto quarter = (last - first) / 4;
+        const TIterator part2 = first + quarter;
+        const TIterator part3 = part2 + quarter;
+        const TIterator part4 = part3 + quarter;
+
+        T acc1{}, acc2{}, acc3{}, acc4{};
+
+        for (std::ptrdiff_t i = 0; i < quarter; ++i)
+        {
+            acc1 += first[i];
+            acc2 += part2[i];
+            acc3 += part3[i];
+            acc4 += part4[i];
+        }
+
+        for (TIterator it = part4 + quarter; it != last; ++it)
+            acc4 += *it;
+
+        acc1 += acc2;
+        acc1 += acc3;
+        acc1 += acc4;
+
+        return acc1;
+    }
+
+    // calls task(index) for every index in [0; count) from thread_count threads; rethrows the first exception
+    template <typename TTask>
+    void for_each_index(unsigned thread_count, std::size_t count, TTask task)
+    {
+        std::atomic<std::size_t> next_index{0};
+        std::exception_ptr error;
+        std::mutex error_mutex;
+
+        auto worker = [&] {
+            try
+            {
+                for (std::size_t index; (index = next_index++) < count;)
+                    task(index);
+            }
+            catch (...)
+            {
+                std::lock_guard lk{error_mutex};
+                if (!error)
+                    error = std::current_exception();
+                next_index = count;
+            }
+        };
+
+        {
+            std::vector<std::jthread> threads;
+            threads.reserve(thread_count - 1);
+            for (unsigned i = 1; i < thread_count; ++i)
+                threads.emplace_back(worker);
+
+            worker();
+        }
+
+        if (error)
+            std::rethrow_exception(error);
+    }
+
+    // calls task(index) for every index in [0; count) - in the pool of the policy or in at most max_threads new threads
+    template <typename TTask>
+    void for_each_index(const Execution::ParallelPolicy& policy, std::size_t count, TTask task, unsigned max_threads = UINT_MAX)
+    {
+        if (policy.pool)
+            parallel_for(*policy.pool, std::views::iota(std::size_t{0}, count), task, 1);
+        else
+            for_each_index(std::min(policy.threads(), max_threads), count, task);
+    }
+
+    template <typename T, std::random_access_iterator TIterator>
+    T accumulate(const Execution::ParallelPolicy& policy, TIterator first, TIterator last)
+    {
+        const std::size_t count = static_cast<std::size_t>(last - first);
+        const std::size_t chunk = chunk_size<T>;
+        const std::size_t chunk_count = (count + chunk - 1) / chunk;
+
+        std::vector<T> partial_results(chunk_count);
+
+        for_each_index(
+            policy, chunk_count,
+            [&](std::size_t index) {
+                const TIterator chunk_first = first + index * chunk;
+                const TIterator chunk_last = first + std::min(count, (index + 1) * chunk);
+                partial_results[index] = accumulate_chunk<T>(chunk_first, chunk_last);
+            },
+            static_cast<unsigned>(std::max<std::size_t>(chunk_count, 1)));
+
+        T result{};
+        for (auto& partial : partial_results)
+            result += partial;
+
+        return result;
+    }
+} // namespace Parallel
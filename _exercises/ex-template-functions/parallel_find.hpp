@@ -0,0 +1,53 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+
+#include "parallel_accumulate.hpp"
+
+namespace Parallel
+{
+    // chunks are small enough to stop soon after a match & large enough to amortize scheduling
+    constexpr std::size_t find_chunk_size = 16 * 1024;
+
+    // position of the first match - find_in_part(part_first, part_last) searches one chunk sequentially
+    // - chunks are taken in ascending order; a chunk that starts after the best match found so far is skipped,
+    //   chunks before it are still searched (they may contain an earlier match)
+    template <std::random_access_iterator TIterator, typename TFindInPart>
+    TIterator find_first(const Execution::ParallelPolicy& policy, TIterator first, TIterator last, TFindInPart find_in_part)
+    {
+        const std::size_t count = static_cast<std::size_t>(last - first);
+        const std::size_t chunk_count = (count + find_chunk_size - 1) / find_chunk_size;
+
+        if (chunk_count <= 1 || policy.threads() == 1)
+            return find_in_part(first, last);
+
+        std::atomic<std::size_t> best{count};
+
+        for_each_index(
+            policy, chunk_count,
+            [&](std::size_t index) {
+                const std::size_t chunk_begin = index * find_chunk_size;
+                if (chunk_begin >= best.load(std::memory_order_relaxed))
+                    return; // cancelled - an earlier match exists
+
+                const TIterator chunk_first = first + chunk_begin;
+                const TIterator chunk_last = first + std::min(count, chunk_begin + find_chunk_size);
+                const TIterator pos = find_in_part(chunk_first, chunk_last);
+
+                if (pos == chunk_last)
+                    return;
+
+                const std::size_t found = static_cast<std::size_t>(pos - first);
+                std::size_t current = best.load(std::memory_order_relaxed);
+                while (found < current && !best.compare_exchange_weak(current, found, std::memory_order_relaxed))
+                {
+                }
+            },
+            static_cast<unsigned>(chunk_count));
+
+        return first + best.load();
+    }
+} // namespace Parallel
@@ -0,0 +1,325 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#if defined(__AVX2__) || defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <immintrin.h>
+#define SIMD_FIND_SSE2
+#endif
+
+#if defined(__AVX2__)
+#define SIMD_FIND_AVX2
+#endif
+
+// aligned vector loads may read past the terminator (never past the page containing it)
+#if defined(__clang__)
+#define SIMD_FIND_NO_SANITIZE_ADDRESS __attribute__((no_sanitize("address")))
+#elif defined(__GNUC__)
+#define SIMD_FIND_NO_SANITIZE_ADDRESS __attribute__((no_sanitize_address))
+#elif defined(_MSC_VER)
+#define SIMD_FIND_NO_SANITIZE_ADDRESS __declspec(no_sanitize_address)
+#else
+#define SIMD_FIND_NO_SANITIZE_ADDRESS
+#endif
+
+namespace Simd
+{
+    enum class Comparison
+    {
+        equal,
+        less,
+        greater
+    };
+
+    // Predicates that can be recognized by find_if & replaced with vector comparisons
+    template <Comparison C, typename T>
+    struct CompareWith
+    {
+        T value;
+
+        constexpr bool operator()(const T& x) const
+        {
+            if constexpr (C == Comparison::equal)
+                return x == value;
+            else if constexpr (C == Comparison::less)
+                return x < value;
+            else
+                return x > value;
+        }
+    };
+
+    template <typename T>
+    constexpr CompareWith<Comparison::equal, T> equal_to(T value)
+    {
+        return {value};
+    }
+
+    template <typename T>
+    constexpr CompareWith<Comparison::less, T> less_than(T value)
+    {
+        return {value};
+    }
+
+    template <typename T>
+    constexpr CompareWith<Comparison::greater, T> greater_than(T value)
+    {
+        return {value};
+    }
+
+    template <typename TPredicate, typename T>
+    constexpr bool is_comparison_with = false;
+
+    template <Comparison C, typename T>
+    constexpr bool is_comparison_with<CompareWith<C, T>, T> = true;
+
+    template <typename TPredicate, typename T>
+    concept ComparisonPredicate = std::is_arithmetic_v<T> && is_comparison_with<TPredicate, T>;
+
+    namespace Kernels
+    {
+        // sets of operations on vector registers used by find_vectorized
+
+#ifdef SIMD_FIND_AVX2
+        struct Avx2Int32
+        {
+            using value_type = std::int32_t;
+            using vector = __m256i;
+            static constexpr std::size_t width = 8;
+
+            static vector load(const value_type* ptr) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr)); }
+            SIMD_FIND_NO_SANITIZE_ADDRESS static vector load_aligned(const value_type* ptr) { return _mm256_load_si256(reinterpret_cast<const __m256i*>(ptr)); }
+            static vector broadcast(value_type value) { return _mm256_set1_epi32(value); }
+            static vector equal(vector a, vector b) { return _mm256_cmpeq_epi32(a, b); }
+            static vector less(vector a, vector b) { return _mm256_cmpgt_epi32(b, a); }
+            static vector greater(vector a, vector b) { return _mm256_cmpgt_epi32(a, b); }
+            static vector either(vector a, vector b) { return _mm256_or_si256(a, b); }
+            static unsigned mask(vector a) { return static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(a))); }
+        };
+
+        struct Avx2Float
+        {
+            using value_type = float;
+            using vector = __m256;
+            static constexpr std::size_t width = 8;
+
+            static vector load(const value_type* ptr) { return _mm256_loadu_ps(ptr); }
+            SIMD_FIND_NO_SANITIZE_ADDRESS static vector load_aligned(const value_type* ptr) { return _mm256_load_ps(ptr); }
+            static vector broadcast(value_type value) { return _mm256_set1_ps(value); }
+            static vector equal(vector a, vector b) { return _mm256_cmp_ps(a, b, _CMP_EQ_OQ); }
+            static vector less(vector a, vector b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+            static vector greater(vector a, vector b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+            static vector either(vector a, vector b) { return _mm256_or_ps(a, b); }
+            static unsigned mask(vector a) { return static_cast<unsigned>(_mm256_movemask_ps(a)); }
+        };
+#endif
+
+#ifdef SIMD_FIND_SSE2
+        struct Sse2Int32
+        {
+            using value_type = std::int32_t;
+            using vector = __m128i;
+            static constexpr std::size_t width = 4;
+
+            static vector load(const value_type* ptr) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr)); }
+            SIMD_FIND_NO_SANITIZE_ADDRESS static vector load_aligned(const value_type* ptr) { return _mm_load_si128(reinterpret_cast<const __m128i*>(ptr)); }
+            static vector broadcast(value_type value) { return _mm_set1_epi32(value); }
+            static vector equal(vector a, vector b) { return _mm_cmpeq_epi32(a, b); }
+            static vector less(vector a, vector b) { return _mm_cmplt_epi32(a, b); }
+            static vector greater(vector a, vector b) { return _mm_cmpgt_epi32(a, b); }
+            static vector either(vector a, vector b) { return _mm_or_si128(a, b); }
+            static unsigned mask(vector a) { return static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(a))); }
+        };
+
+        struct Sse2Float
+        {
+            using value_type = float;
+            using vector = __m128;
+            static constexpr std::size_t width = 4;
+
+            static vector load(const value_type* ptr) { return _mm_loadu_ps(ptr); }
+            SIMD_FIND_NO_SANITIZE_ADDRESS static vector load_aligned(const value_type* ptr) { return _mm_load_ps(ptr); }
+            static vector broadcast(value_type value) { return _mm_set1_ps(value); }
+            static vector equal(vector a, vector b) { return _mm_cmpeq_ps(a, b); }
+            static vector less(vector a, vector b) { return _mm_cmplt_ps(a, b); }
+            static vector greater(vector a, vector b) { return _mm_cmpgt_ps(a, b); }
+            static vector either(vector a, vector b) { return _mm_or_ps(a, b); }
+            static unsigned mask(vector a) { return static_cast<unsigned>(_mm_movemask_ps(a)); }
+        };
+#endif
+
+        template <typename T>
+        struct Vectorized
+        {
+            using type = void;
+        };
+
+#if defined(SIMD_FIND_AVX2)
+        template <>
+        struct Vectorized<std::int32_t>
+        {
+            using type = Avx2Int32;
+        };
+
+        template <>
+        struct Vectorized<float>
+        {
+            using type = Avx2Float;
+        };
+#elif defined(SIMD_FIND_SSE2)
+        template <>
+        struct Vectorized<std::int32_t>
+        {
+            using type = Sse2Int32;
+        };
+
+        template <>
+        struct Vectorized<float>
+        {
+            using type = Sse2Float;
+        };
+#endif
+
+        // 4 vectors (16-32 items) per iteration - masks are combined, so there is one branch per block
+        template <typename TOps, Comparison C>
+        const typename TOps::value_type* find_vectorized(const typename TOps::value_type* first, const typename TOps::value_type* last,
+            typename TOps::value_type value)
+        {
+            using vector = typename TOps::vector;
+            constexpr std::ptrdiff_t width = TOps::width;
+            constexpr std::ptrdiff_t block = 4 * width;
+
+            const vector needle = TOps::broadcast(value);
+
+            auto compare = [needle](const auto* ptr) {
+                if constexpr (C == Comparison::equal)
+                    return TOps::equal(TOps::load(ptr), needle);
+                else if constexpr (C == Comparison::less)
+                    return TOps::less(TOps::load(ptr), needle);
+                else
+                    return TOps::greater(TOps::load(ptr), needle);
+            };
+
+            for (; last - first >= block; first += block)
+            {
+                const vector m0 = compare(first);
+                const vector m1 = compare(first + width);
+                const vector m2 = compare(first + 2 * width);
+                const vector m3 = compare(first + 3 * width);
+
+                if (TOps::mask(TOps::either(TOps::either(m0, m1), TOps::either(m2, m3))) != 0)
+                {
+                    for (const vector m : {m0, m1, m2, m3})
+                    {
+                        if (const unsigned mask = TOps::mask(m))
+                            return first + std::countr_zero(mask);
+                        first += width;
+                    }
+                }
+            }
+
+            for (; last - first >= width; first += width)
+            {
+                if (const unsigned mask = TOps::mask(compare(first)))
+                    return first + std::countr_zero(mask);
+            }
+
+            return std::find_if(first, last, CompareWith<C, typename TOps::value_type>{value});
+        }
+
+        // portable kernel - a block of items is tested without early exit, so the compiler can vectorize it
+        template <typename T, typename TPredicate>
+        const T* find_blocked(const T* first, const T* last, TPredicate pred)
+        {
+            constexpr std::ptrdiff_t block = 32;
+
+            for (; last - first >= block; first += block)
+            {
+                bool found = false;
+                for (std::ptrdiff_t i = 0; i < block; ++i)
+                    found |= pred(first[i]);
+
+                if (found)
+                    break;
+            }
+
+            return std::find_if(first, last, pred);
+        }
+
+        // search for a value that is known to be present (no end pointer - like memchr/strlen)
+        // - loads are aligned to a block of 4 vectors, so a load never crosses a page boundary
+        // - stops after at least limit items without the value (never past the value)
+        template <typename TOps>
+        SIMD_FIND_NO_SANITIZE_ADDRESS const typename TOps::value_type* find_terminator_vectorized(const typename TOps::value_type* first,
+            typename TOps::value_type value, std::size_t limit)
+        {
+            using vector = typename TOps::vector;
+            constexpr std::size_t width = TOps::width;
+            constexpr std::size_t block = 4 * width;
+
+            for (; reinterpret_cast<std::uintptr_t>(first) % (block * sizeof(*first)) != 0; ++first, --limit)
+            {
+                if (limit == 0 || *first == value)
+                    return first;
+            }
+
+            const vector needle = TOps::broadcast(value);
+
+            for (std::size_t scanned = 0; scanned < limit; scanned += block, first += block)
+            {
+                const vector m0 = TOps::equal(TOps::load_aligned(first), needle);
+                const vector m1 = TOps::equal(TOps::load_aligned(first + width), needle);
+                const vector m2 = TOps::equal(TOps::load_aligned(first + 2 * width), needle);
+                const vector m3 = TOps::equal(TOps::load_aligned(first + 3 * width), needle);
+
+                if (TOps::mask(TOps::either(TOps::either(m0, m1), TOps::either(m2, m3))) != 0)
+                {
+                    for (const vector m : {m0, m1, m2, m3})
+                    {
+                        if (const unsigned mask = TOps::mask(m))
+                            return first + std::countr_zero(mask);
+                        first += width;
+                    }
+                }
+            }
+
+            return first;
+        }
+    } // namespace Kernels
+
+    template <typename T, Comparison C>
+    const T* find_if(const T* first, const T* last, CompareWith<C, T> pred)
+    {
+        using TOps = typename Kernels::Vectorized<std::remove_cv_t<T>>::type;
+
+        if constexpr (!std::is_void_v<TOps>)
+            return Kernels::find_vectorized<TOps, C>(first, last, pred.value);
+        else
+            return Kernels::find_blocked(first, last, pred);
+    }
+
+    // pointer to the first item equal to value - the value must be present in memory starting at first
+    // - with limit the search may stop earlier: after at least limit items (but never past the value)
+    template <typename T>
+    const T* find_terminator(const T* first, T value, std::size_t limit = std::numeric_limits<std::size_t>::max())
+    {
+        using TOps = typename Kernels::Vectorized<std::remove_cv_t<T>>::type;
+
+        if constexpr (!std::is_void_v<TOps>)
+        {
+            // the kernel relies on items being aligned to their size
+            if (reinterpret_cast<std::uintptr_t>(first) % sizeof(T) == 0)
+                return Kernels::find_terminator_vectorized<TOps>(first, value, limit);
+        }
+
+        for (; limit != 0 && !(*first == value); --limit)
+            ++first;
+
+        return first;
+    }
+} // namespace Simd
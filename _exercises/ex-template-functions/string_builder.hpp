@@ -0,0 +1,97 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Strings
+{
+    template <typename T>
+    constexpr bool is_basic_string = false;
+
+    template <typename TChar, typename TTraits, typename TAllocator>
+    constexpr bool is_basic_string<std::basic_string<TChar, TTraits, TAllocator>> = true;
+
+    // Appends text to chunks of geometrically growing capacity - appended text is never moved
+    // until str() copies everything once into a string of exact size
+    template <typename TString>
+    class StringBuilder
+    {
+        using view_type = std::basic_string_view<typename TString::value_type, typename TString::traits_type>;
+
+        std::vector<TString> chunks;
+        std::size_t total_size = 0;
+        std::size_t next_capacity = 256;
+
+    public:
+        void append(view_type text)
+        {
+            if (chunks.empty() || chunks.back().capacity() - chunks.back().size() < text.size())
+            {
+                chunks.emplace_back().reserve(std::max(next_capacity, text.size()));
+                next_capacity *= 2;
+            }
+
+            chunks.back().append(text);
+            total_size += text.size();
+        }
+
+        std::size_t size() const
+        {
+            return total_size;
+        }
+
+        TString str() const
+        {
+            TString result;
+            result.reserve(total_size);
+
+            for (const auto& chunk : chunks)
+                result.append(chunk);
+
+            return result;
+        }
+    };
+
+    // concatenation with a single allocation for multi-pass ranges
+    template <typename TString, std::input_iterator TIterator, std::sentinel_for<TIterator> TSentinel>
+    TString concat(TIterator first, TSentinel last)
+    {
+        if constexpr (std::forward_iterator<TIterator>)
+        {
+            std::size_t total_size = 0;
+            for (auto it = first; it != last; ++it)
+                total_size += std::size(*it);
+
+            TString result;
+
+#if __cpp_lib_string_resize_and_overwrite
+            // copies items directly to the buffer - no capacity checks & null-terminator writes per item
+            result.resize_and_overwrite(total_size, [&first, &last](auto* buffer, std::size_t size) {
+                for (auto* out = buffer; first != last; ++first)
+                    out = std::ranges::copy(*first, out).out;
+                return size;
+            });
+#else
+            result.reserve(total_size);
+
+            for (; first != last; ++first)
+                result.append(*first);
+#endif
+
+            return result;
+        }
+        else
+        {
+            StringBuilder<TString> builder;
+
+            for (; first != last; ++first)
+                builder.append(*first);
+
+            return builder.str();
+        }
+    }
+} // namespace Strings
@@ -0,0 +1,188 @@
+#pragma once
+
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+
+// Summation policies for TODO::accumulate: accumulate<Summation::Kahan>(first, last)
+// - lanes of independent accumulators let the compiler vectorize the loops
+//   (only for arithmetic types - lanes reorder the operands, other types are added sequentially)
+//   (compensated summation requires strict IEEE semantics - do not compile with -ffast-math)
+namespace Summation
+{
+    // accumulator type that does not overflow/lose precision as fast as T
+    template <typename T>
+    struct Wider
+    {
+        using type = T;
+    };
+
+    template <std::signed_integral T>
+    struct Wider<T>
+    {
+        using type = std::int64_t;
+    };
+
+    template <std::unsigned_integral T>
+    struct Wider<T>
+    {
+        using type = std::uint64_t;
+    };
+
+    template <>
+    struct Wider<float>
+    {
+        using type = double;
+    };
+
+    template <>
+    struct Wider<double>
+    {
+        using type = long double;
+    };
+
+    template <typename T>
+    using wider_t = typename Wider<T>::type;
+
+    constexpr std::size_t lanes = 8;
+
+    namespace Detail
+    {
+        // passes items to add(lane, item) - consecutive items go to consecutive lanes
+        template <std::size_t Lanes, std::input_iterator TIterator, std::sentinel_for<TIterator> TSentinel, typename TAdd>
+        void for_each_in_lanes(TIterator first, TSentinel last, TAdd add)
+        {
+            if constexpr (std::random_access_iterator<TIterator> && std::sized_sentinel_for<TSentinel, TIterator>)
+            {
+                const auto count = last - first;
+                constexpr auto block = static_cast<std::iter_difference_t<TIterator>>(Lanes);
+
+                std::iter_difference_t<TIterator> i = 0;
+                for (; i + block <= count; i += block)
+                {
+                    for (std::size_t lane = 0; lane < Lanes; ++lane)
+                        add(lane, first[i + lane]);
+                }
+
+                for (std::size_t lane = 0; i < count; ++i, ++lane)
+                    add(lane, first[i]);
+            }
+            else
+            {
+                for (std::size_t lane = 0; first != last; ++first, lane = (lane + 1) % Lanes)
+                    add(lane, *first);
+            }
+        }
+
+        // combines lanes pairwise - always in the same order
+        template <typename T, std::size_t Lanes>
+        T reduce_lanes(T (&acc)[Lanes])
+        {
+            for (std::size_t width = Lanes / 2; width > 0; width /= 2)
+            {
+                for (std::size_t i = 0; i < width; ++i)
+                    acc[i] += acc[i + width];
+            }
+
+            return acc[0];
+        }
+
+        // consecutive items go to different lanes, so operands are reordered - strings & other types
+        // where += is not commutative are added sequentially
+        template <typename TAcc, std::input_iterator TIterator, std::sentinel_for<TIterator> TSentinel>
+        TAcc sum_in_lanes(TIterator first, TSentinel last)
+        {
+            if constexpr (std::is_arithmetic_v<TAcc>)
+            {
+                TAcc acc[lanes]{};
+                for_each_in_lanes<lanes>(first, last, [&acc](std::size_t lane, const auto& x) { acc[lane] += static_cast<TAcc>(x); });
+
+                return reduce_lanes(acc);
+            }
+            else
+            {
+                TAcc acc{};
+                for (; first != last; ++first)
+                    acc += *first;
+
+                return acc;
+            }
+        }
+
+        // Neumaier's step: sum + compensation hold the exact sum of added items
+        template <std::floating_point T>
+        void add_compensated(T& sum, T& compensation, T x)
+        {
+            const T total = sum + x;
+            compensation += std::abs(sum) >= std::abs(x) ? (sum - total) + x : (x - total) + sum;
+            sum = total;
+        }
+    } // namespace Detail
+
+    // sequential result += item with T deduced from items (the default)
+    struct Plain
+    {
+    };
+
+    // accumulator of a wider type: int -> int64_t, float -> double, double -> long double
+    struct Widened
+    {
+        template <typename T, std::input_iterator TIterator, std::sentinel_for<TIterator> TSentinel>
+        static wider_t<T> sum(TIterator first, TSentinel last)
+        {
+            return Detail::sum_in_lanes<wider_t<T>>(first, last);
+        }
+    };
+
+    // compensated summation (Neumaier's improvement of Kahan's algorithm) - error does not grow with the number of items
+    struct Kahan
+    {
+        template <std::floating_point T, std::input_iterator TIterator, std::sentinel_for<TIterator> TSentinel>
+        static T sum(TIterator first, TSentinel last)
+        {
+            T sums[lanes]{};
+            T compensations[lanes]{};
+            Detail::for_each_in_lanes<lanes>(first, last, [&](std::size_t lane, T x) { Detail::add_compensated(sums[lane], compensations[lane], x); });
+
+            T total{};
+            T compensation{};
+            for (std::size_t lane = 0; lane < lanes; ++lane)
+            {
+                Detail::add_compensated(total, compensation, sums[lane]);
+                compensation += compensations[lane];
+            }
+
+            return total + compensation;
+        }
+    };
+
+    // recursive halving - error grows with log(n) instead of n
+    struct Pairwise
+    {
+        static constexpr std::ptrdiff_t block_size = 128; // summed directly
+
+        template <typename T, std::random_access_iterator TIterator, std::sized_sentinel_for<TIterator> TSentinel>
+        static T sum(TIterator first, TSentinel last)
+        {
+            return sum_range<T>(first, first + (last - first));
+        }
+
+    private:
+        template <typename T, std::random_access_iterator TIterator>
+        static T sum_range(TIterator first, TIterator last)
+        {
+            const auto count = last - first;
+
+            if (count <= block_size)
+                return Detail::sum_in_lanes<T>(first, last);
+
+            // split on a block boundary
+            const auto half = (count / 2 + block_size - 1) / block_size * block_size;
+
+            return sum_range<T>(first, first + half) + sum_range<T>(first + half, last);
+        }
+    };
+} // namespace Summation
@@ -0,0 +1,487 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <ranges>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Chase-Lev work-stealing deque (Le, Pop, Cohen, Zappa Nardelli: "Correct and Efficient Work-Stealing for Weak Memory Models")
+// - the owner thread pushes & pops at the bottom (LIFO), other threads steal from the top (FIFO)
+template <typename T>
+    requires std::is_trivially_copyable_v<T>
+class WorkStealingDeque
+{
+    class Buffer
+    {
+        std::int64_t mask;
+        std::unique_ptr<std::atomic<T>[]> items;
+
+    public:
+        explicit Buffer(std::int64_t capacity)
+            : mask{capacity - 1}
+            , items{new std::atomic<T>[static_cast<std::size_t>(capacity)]}
+        {
+        }
+
+        std::int64_t capacity() const
+        {
+            return mask + 1;
+        }
+
+        T get(std::int64_t index) const
+        {
+            return items[index & mask].load(std::memory_order_relaxed);
+        }
+
+        void put(std::int64_t index, T item)
+        {
+            items[index & mask].store(item, std::memory_order_relaxed);
+        }
+
+        std::unique_ptr<Buffer> grow(std::int64_t top, std::int64_t bottom) const
+        {
+            auto bigger = std::make_unique<Buffer>(2 * capacity());
+            for (std::int64_t i = top; i != bottom; ++i)
+                bigger->put(i, get(i));
+            return bigger;
+        }
+    };
+
+    alignas(64) std::atomic<std::int64_t> top{0};
+    alignas(64) std::atomic<std::int64_t> bottom{0};
+    std::atomic<Buffer*> buffer;
+    std::vector<std::unique_ptr<Buffer>> buffers; // old buffers may still be read by thieves - released with the deque
+
+public:
+    explicit WorkStealingDeque(std::int64_t capacity = 256)
+    {
+        buffers.push_back(std::make_unique<Buffer>(std::bit_ceil(static_cast<std::uint64_t>(capacity))));
+        buffer.store(buffers.back().get(), std::memory_order_relaxed);
+    }
+
+    WorkStealingDeque(const WorkStealingDeque&) = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+    // owner only
+    void push(T item)
+    {
+        const std::int64_t b = bottom.load(std::memory_order_relaxed);
+        const std::int64_t t = top.load(std::memory_order_acquire);
+        Buffer* current = buffer.load(std::memory_order_relaxed);
+
+        if (b - t > current->capacity() - 1)
+        {
+            buffers.push_back(current->grow(t, b));
+            current = buffers.back().get();
+            buffer.store(current, std::memory_order_release);
+        }
+
+        current->put(b, item);
+        bottom.store(b + 1, std::memory_order_release); // publishes the item to thieves (instead of a release fence)
+    }
+
+    // owner only
+    std::optional<T> pop()
+    {
+        const std::int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+        Buffer* current = buffer.load(std::memory_order_relaxed);
+        bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::int64_t t = top.load(std::memory_order_relaxed);
+
+        if (t > b) // empty
+        {
+            bottom.store(b + 1, std::memory_order_relaxed);
+            return std::nullopt;
+        }
+
+        std::optional<T> item = current->get(b);
+
+        if (t == b) // last item - race with thieves
+        {
+            if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                item = std::nullopt;
+            bottom.store(b + 1, std::memory_order_relaxed);
+        }
+
+        return item;
+    }
+
+    // any thread; may fail when another thread takes the same item
+    std::optional<T> steal()
+    {
+        std::int64_t t = top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const std::int64_t b = bottom.load(std::memory_order_acquire);
+
+        if (t >= b)
+            return std::nullopt;
+
+        const T item = buffer.load(std::memory_order_acquire)->get(t);
+
+        if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            return std::nullopt;
+
+        return item;
+    }
+
+    bool empty() const
+    {
+        return bottom.load(std::memory_order_relaxed) <= top.load(std::memory_order_relaxed);
+    }
+};
+
+// Pool of threads with a work-stealing deque per worker
+// - tasks spawned by a worker go to its own deque; idle workers steal from the others
+class ThreadPool
+{
+    class Task
+    {
+    public:
+        virtual ~Task() = default;
+        virtual void run() = 0;
+    };
+
+    template <typename TFunction>
+    class TaskFor : public Task
+    {
+        TFunction f;
+
+    public:
+        explicit TaskFor(TFunction function)
+            : f{std::move(function)}
+        {
+        }
+
+        void run() override
+        {
+            f();
+        }
+    };
+
+    struct Worker
+    {
+        WorkStealingDeque<Task*> tasks;
+        std::jthread thread;
+    };
+
+    std::vector<std::unique_ptr<Worker>> workers;
+
+    std::mutex injected_mutex;
+    std::deque<Task*> injected; // tasks submitted from threads outside of the pool
+    std::atomic<std::size_t> injected_count{0};
+
+    std::atomic<std::uint32_t> epoch{0}; // incremented on every new task - idle workers wait for a change
+    std::atomic<int> sleeping{0};
+    std::atomic<bool> waking{false}; // a sleeping worker is being woken up - no more notifications (system calls) until it runs
+    std::atomic<bool> stopping{false};
+
+    inline static thread_local ThreadPool* current_pool = nullptr;
+    inline static thread_local Worker* current_worker = nullptr;
+
+    Worker* worker_of_this_thread() const
+    {
+        return current_pool == this ? current_worker : nullptr;
+    }
+
+    void push(Task* task)
+    {
+        if (Worker* self = worker_of_this_thread())
+        {
+            self->tasks.push(task);
+        }
+        else
+        {
+            std::lock_guard lk{injected_mutex};
+            injected.push_back(task);
+            injected_count.fetch_add(1, std::memory_order_release);
+        }
+
+        epoch.fetch_add(1, std::memory_order_seq_cst);
+        wake_one();
+    }
+
+    void wake_one()
+    {
+        if (sleeping.load(std::memory_order_seq_cst) > 0 && !waking.load(std::memory_order_relaxed) && !waking.exchange(true))
+            epoch.notify_one();
+    }
+
+    Task* find_task(Worker* self)
+    {
+        if (self)
+        {
+            if (auto task = self->tasks.pop())
+                return *task;
+        }
+
+        // random first victim spreads thieves over the workers
+        thread_local std::uint32_t random_state = static_cast<std::uint32_t>(std::hash<std::thread::id>{}(std::this_thread::get_id())) | 1;
+        random_state ^= random_state << 13;
+        random_state ^= random_state >> 17;
+        random_state ^= random_state << 5;
+
+        const std::size_t first_victim = random_state % workers.size();
+        for (std::size_t i = 0; i < workers.size(); ++i)
+        {
+            Worker* victim = workers[(first_victim + i) % workers.size()].get();
+            if (victim == self)
+                continue;
+
+            if (auto task = victim->tasks.steal())
+                return *task;
+        }
+
+        if (injected_count.load(std::memory_order_acquire) > 0)
+        {
+            std::lock_guard lk{injected_mutex};
+            if (!injected.empty())
+            {
+                Task* task = injected.front();
+                injected.pop_front();
+                injected_count.fetch_sub(1, std::memory_order_relaxed);
+                return task;
+            }
+        }
+
+        return nullptr;
+    }
+
+    static void execute(Task* task)
+    {
+        std::unique_ptr<Task> owned{task};
+        owned->run();
+    }
+
+    void worker_loop(Worker* self)
+    {
+        current_pool = this;
+        current_worker = self;
+
+        bool woken = false;
+
+        while (true)
+        {
+            if (Task* task = find_task(self))
+            {
+                // more tasks may be queued - the next sleeping worker is woken up in a chain
+                if (std::exchange(woken, false))
+                    wake_one();
+
+                execute(task);
+                continue;
+            }
+
+            sleeping.fetch_add(1, std::memory_order_seq_cst);
+            const std::uint32_t seen_epoch = epoch.load(std::memory_order_seq_cst);
+
+            // tasks pushed before the epoch was read are visible here, later ones change the epoch
+            const bool has_tasks =
+                injected_count.load() > 0 || std::ranges::any_of(workers, [](const auto& worker) { return !worker->tasks.empty(); });
+
+            if (!has_tasks)
+            {
+                if (stopping.load())
+                {
+                    sleeping.fetch_sub(1, std::memory_order_seq_cst);
+                    return;
+                }
+
+                epoch.wait(seen_epoch, std::memory_order_seq_cst);
+            }
+
+            // this worker may be the one that was notified
+            sleeping.fetch_sub(1, std::memory_order_seq_cst);
+            waking.store(false);
+            woken = true;
+        }
+    }
+
+public:
+    explicit ThreadPool(unsigned thread_count = std::max(1u, std::thread::hardware_concurrency()))
+    {
+        workers.reserve(thread_count);
+        for (unsigned i = 0; i < thread_count; ++i)
+            workers.push_back(std::make_unique<Worker>());
+
+        for (auto& worker : workers)
+            worker->thread = std::jthread{[this, w = worker.get()] { worker_loop(w); }};
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // waits until all submitted tasks are executed
+    ~ThreadPool()
+    {
+        stopping = true;
+        epoch.fetch_add(1);
+        epoch.notify_all();
+
+        for (auto& worker : workers)
+            worker->thread.join();
+    }
+
+    unsigned size() const
+    {
+        return static_cast<unsigned>(workers.size());
+    }
+
+    // fire & forget - an exception thrown by the task terminates the program (as in std::thread)
+    template <typename TFunction>
+    void submit(TFunction&& f)
+    {
+        push(new TaskFor<std::decay_t<TFunction>>(std::forward<TFunction>(f)));
+    }
+
+    // executes pending tasks of the pool while condition is true (a thread waiting for tasks helps to execute them)
+    template <typename TCondition>
+    void help_while(TCondition condition)
+    {
+        Worker* self = worker_of_this_thread();
+
+        while (condition())
+        {
+            if (Task* task = find_task(self))
+                execute(task);
+            else
+                std::this_thread::yield();
+        }
+    }
+};
+
+// Fork-join: tasks run in the pool, wait() returns when all of them are finished & rethrows the first exception
+class TaskGroup
+{
+    ThreadPool& pool;
+    std::atomic<std::size_t> pending{0};
+    std::exception_ptr error;
+    std::mutex error_mutex;
+
+    void wait_for_tasks()
+    {
+        pool.help_while([this] { return pending.load(std::memory_order_acquire) > 0; });
+    }
+
+public:
+    explicit TaskGroup(ThreadPool& thread_pool)
+        : pool{thread_pool}
+    {
+    }
+
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    ~TaskGroup()
+    {
+        wait_for_tasks();
+    }
+
+    template <typename TFunction>
+    void run(TFunction&& f)
+    {
+        pending.fetch_add(1, std::memory_order_relaxed);
+
+        pool.submit([this, f = std::forward<TFunction>(f)]() mutable {
+            try
+            {
+                f();
+            }
+            catch (...)
+            {
+                std::lock_guard lk{error_mutex};
+                if (!error)
+                    error = std::current_exception();
+            }
+
+            pending.fetch_sub(1, std::memory_order_release);
+        });
+    }
+
+    void wait()
+    {
+        wait_for_tasks();
+
+        if (error)
+            std::rethrow_exception(std::exchange(error, nullptr));
+    }
+};
+
+// calls f(item) for every item of the range; the range is split in halves down to grain_size items
+// and the halves are executed as tasks (grain_size == 0 - about 8 tasks per worker)
+template <std::ranges::random_access_range TRange, typename TFunction>
+    requires std::ranges::sized_range<TRange>
+void parallel_for(ThreadPool& pool, TRange&& range, TFunction f, std::size_t grain_size = 0)
+{
+    const auto first = std::ranges::begin(range);
+    const std::size_t count = std::ranges::size(range);
+
+    if (grain_size == 0)
+        grain_size = std::max<std::size_t>(1, count / (8 * pool.size()));
+
+    // declared before the group - if f throws inline, ~TaskGroup waits for the tasks referring to run_part
+    auto run_part = [&first, &f, grain_size](auto& self, TaskGroup& group, std::size_t begin, std::size_t end) -> void {
+        while (end - begin > grain_size)
+        {
+            const std::size_t middle = begin + (end - begin) / 2;
+            group.run([&self, &group, middle, end] { self(self, group, middle, end); });
+            end = middle;
+        }
+
+        for (std::size_t i = begin; i != end; ++i)
+            f(first[i]);
+    };
+
+    TaskGroup group{pool};
+    run_part(run_part, group, 0, count);
+    group.wait();
+}
+
+// reduces items with reduce(acc, item) in chunks of grain_size items; chunk results are combined in order,
+// so the result does not depend on the number of threads (reduce must be associative)
+// (grain_size == 0 - a fixed chunk size; unlike parallel_for it must not depend on pool.size())
+template <std::ranges::random_access_range TRange, typename T, typename TReduce = std::plus<>>
+    requires std::ranges::sized_range<TRange>
+T parallel_reduce(ThreadPool& pool, TRange&& range, T init, TReduce reduce = {}, std::size_t grain_size = 0)
+{
+    const auto first = std::ranges::begin(range);
+    const std::size_t count = std::ranges::size(range);
+
+    if (grain_size == 0)
+        grain_size = 4096;
+
+    const std::size_t chunk_count = (count + grain_size - 1) / grain_size;
+
+    std::vector<std::optional<T>> partial_results(chunk_count);
+
+    parallel_for(
+        pool, std::views::iota(std::size_t{0}, chunk_count),
+        [&](std::size_t chunk) {
+            const std::size_t begin = chunk * grain_size;
+            const std::size_t end = std::min(count, begin + grain_size);
+
+            T acc = first[begin];
+            for (std::size_t i = begin + 1; i != end; ++i)
+                acc = reduce(std::move(acc), first[i]);
+
+            partial_results[chunk] = std::move(acc);
+        },
+        1);
+
+    for (auto& partial : partial_results)
+        init = reduce(std::move(init), std::move(*partial));
+
+    return init;
+}
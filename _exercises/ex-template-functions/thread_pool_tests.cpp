@@ -0,0 +1,294 @@
+#include <algorithm>
+#include <atomic>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(HAS_TBB) || defined(_MSC_VER)
+#include <execution>
+#define HAS_PARALLEL_STL
+#endif
+
+#include "parallel_accumulate.hpp"
+#include "thread_pool.hpp"
+
+TEST_CASE("work-stealing deque", "[thread_pool]")
+{
+    WorkStealingDeque<int> deque{4};
+
+    SECTION("owner pops in LIFO order, thieves steal in FIFO order")
+    {
+        for (int i = 0; i < 10; ++i) // grows the buffer
+            deque.push(i);
+
+        REQUIRE(deque.pop() == 9);
+        REQUIRE(deque.steal() == 0);
+        REQUIRE(deque.pop() == 8);
+        REQUIRE(deque.steal() == 1);
+    }
+
+    SECTION("empty")
+    {
+        REQUIRE(deque.empty());
+        REQUIRE(deque.pop() == std::nullopt);
+        REQUIRE(deque.steal() == std::nullopt);
+    }
+
+    SECTION("every item is taken exactly once by the owner or a thief")
+    {
+        constexpr int count = 100'000;
+        std::vector<std::atomic<int>> taken(count);
+        std::atomic<bool> done{false};
+
+        {
+            std::vector<std::jthread> thieves;
+            for (int t = 0; t < 3; ++t)
+                thieves.emplace_back([&] {
+                    while (!done || !deque.empty())
+                    {
+                        if (auto item = deque.steal())
+                            ++taken[*item];
+                    }
+                });
+
+            for (int i = 0; i < count; ++i)
+            {
+                deque.push(i);
+                if (i % 3 == 0)
+                {
+                    if (auto item = deque.pop())
+                        ++taken[*item];
+                }
+            }
+
+            while (auto item = deque.pop())
+                ++taken[*item];
+
+            done = true;
+        }
+
+        REQUIRE(std::all_of(taken.begin(), taken.end(), [](const auto& t) { return t == 1; }));
+    }
+}
+
+TEST_CASE("thread pool", "[thread_pool]")
+{
+    ThreadPool pool{4};
+    REQUIRE(pool.size() == 4);
+
+    SECTION("submitted tasks are executed before the pool is destroyed")
+    {
+        std::atomic<int> counter{0};
+        {
+            ThreadPool local_pool{2};
+            for (int i = 0; i < 1000; ++i)
+                local_pool.submit([&counter] { ++counter; });
+        }
+
+        REQUIRE(counter == 1000);
+    }
+
+    SECTION("nested task groups")
+    {
+        std::atomic<int> counter{0};
+        TaskGroup outer{pool};
+
+        for (int i = 0; i < 10; ++i)
+            outer.run([&] {
+                TaskGroup inner{pool};
+                for (int j = 0; j < 10; ++j)
+                    inner.run([&] { ++counter; });
+                inner.wait();
+            });
+
+        outer.wait();
+        REQUIRE(counter == 100);
+    }
+
+    SECTION("exception from a task is rethrown by wait")
+    {
+        TaskGroup group{pool};
+        std::atomic<int> counter{0};
+
+        for (int i = 0; i < 100; ++i)
+            group.run([&, i] {
+                ++counter;
+                if (i == 42)
+                    throw std::runtime_error("task failed");
+            });
+
+        REQUIRE_THROWS_AS(group.wait(), std::runtime_error);
+        REQUIRE(counter == 100);
+    }
+
+    SECTION("parallel_for visits every item exactly once")
+    {
+        std::vector<int> data(100'003, 0);
+
+        for (std::size_t grain_size : {0u, 1u, 1000u, 1'000'000u})
+        {
+            parallel_for(pool, data, [](int& x) { ++x; }, grain_size);
+        }
+
+        REQUIRE(std::all_of(data.begin(), data.end(), [](int x) { return x == 4; }));
+    }
+
+    SECTION("parallel_for over a view")
+    {
+        std::vector<std::atomic<int>> hits(1000);
+
+        parallel_for(pool, std::views::iota(0, 1000), [&](int i) { ++hits[i]; });
+
+        REQUIRE(std::all_of(hits.begin(), hits.end(), [](const auto& h) { return h == 1; }));
+    }
+
+    SECTION("parallel_for - exception thrown inline while tasks are pending")
+    {
+        std::vector<int> data(1000, 0);
+        std::atomic<int> visited{0};
+
+        auto f = [&](int& x) {
+            if (&x == &data[0]) // the first item is processed by the calling thread after all the splits
+                throw std::runtime_error("item failed");
+            ++visited;
+        };
+
+        REQUIRE_THROWS_AS(parallel_for(pool, data, f, 1), std::runtime_error);
+        REQUIRE(visited == 999); // all the tasks finished before parallel_for returned
+    }
+
+    SECTION("parallel_for - empty range")
+    {
+        std::vector<int> empty;
+        parallel_for(pool, empty, [](int&) { FAIL(); });
+    }
+
+    SECTION("parallel_reduce")
+    {
+        std::vector<long long> data(1'000'000);
+        std::iota(data.begin(), data.end(), 0LL);
+
+        REQUIRE(parallel_reduce(pool, data, 0LL) == std::accumulate(data.begin(), data.end(), 0LL));
+        REQUIRE(parallel_reduce(pool, std::vector<long long>{}, 42LL) == 42LL);
+    }
+
+    SECTION("parallel_reduce - chunks are combined in order")
+    {
+        std::vector<std::string> words(10'000);
+        for (size_t i = 0; i < words.size(); ++i)
+            words[i] = std::to_string(i % 10);
+
+        REQUIRE(parallel_reduce(pool, words, std::string{}, std::plus<>{}, 100) == std::accumulate(words.begin(), words.end(), std::string{}));
+    }
+
+    SECTION("parallel_reduce - result does not depend on number of threads")
+    {
+        std::vector<double> data(1'000'000);
+        for (size_t i = 0; i < data.size(); ++i)
+            data[i] = 1.0 / (i + 1);
+
+        ThreadPool single_thread{1};
+
+        REQUIRE(parallel_reduce(pool, data, 0.0) == parallel_reduce(single_thread, data, 0.0));
+    }
+
+    SECTION("parallel_reduce - grain_size == 0 selects a fixed chunk size")
+    {
+        std::vector<double> data(100'003);
+        for (size_t i = 0; i < data.size(); ++i)
+            data[i] = 1.0 / (i + 1);
+
+        ThreadPool single_thread{1};
+
+        REQUIRE(parallel_reduce(pool, data, 0.0, std::plus<>{}, 0) == parallel_reduce(pool, data, 0.0));
+        REQUIRE(parallel_reduce(pool, data, 0.0, std::plus<>{}, 0) == parallel_reduce(single_thread, data, 0.0, std::plus<>{}, 0));
+        REQUIRE(parallel_reduce(pool, std::vector<double>{}, 1.0, std::plus<>{}, 0) == 1.0);
+    }
+
+    SECTION("algorithms parameterized with the pool")
+    {
+        std::vector<double> data(1'000'000);
+        for (size_t i = 0; i < data.size(); ++i)
+            data[i] = 1.0 / (i + 1);
+
+        const Execution::ParallelPolicy on_pool{.pool = &pool};
+
+        REQUIRE(on_pool.threads() == 4);
+        REQUIRE(Parallel::accumulate<double>(on_pool, data.begin(), data.end()) ==
+                Parallel::accumulate<double>(Execution::ParallelPolicy{1}, data.begin(), data.end()));
+    }
+}
+
+TEST_CASE("thread pool - fork-join overhead & scaling", "[.][benchmark][thread_pool]")
+{
+    const unsigned max_threads = std::max(1u, std::thread::hardware_concurrency());
+
+    SECTION("fork-join overhead - 1000 empty tasks")
+    {
+        ThreadPool pool{max_threads};
+        std::vector<int> data(1000);
+
+        BENCHMARK("parallel_for - default grain")
+        {
+            parallel_for(pool, data, [](int& x) { x = 0; });
+        };
+
+        BENCHMARK("parallel_for - grain 1")
+        {
+            parallel_for(pool, data, [](int& x) { x = 0; }, 1);
+        };
+
+        BENCHMARK("TaskGroup - flat")
+        {
+            TaskGroup group{pool};
+            for (int& x : data)
+                group.run([&x] { x = 0; });
+            group.wait();
+        };
+
+        BENCHMARK("new thread per worker (Parallel::for_each_index)")
+        {
+            Parallel::for_each_index(max_threads, data.size(), [&](std::size_t i) { data[i] = 0; });
+        };
+
+#ifdef HAS_PARALLEL_STL
+        BENCHMARK("std::for_each(std::execution::par)")
+        {
+            std::for_each(std::execution::par, data.begin(), data.end(), [](int& x) { x = 0; });
+        };
+#endif
+    }
+
+    SECTION("scaling - 10^7 doubles")
+    {
+        std::vector<double> data(10'000'000, 2.0);
+        auto work = [](double& x) { x = std::sqrt(x) + 1.0; };
+
+        BENCHMARK("sequential")
+        {
+            std::for_each(data.begin(), data.end(), work);
+        };
+
+        for (unsigned thread_count = 1; thread_count <= max_threads; ++thread_count)
+        {
+            ThreadPool pool{thread_count};
+
+            BENCHMARK("parallel_for - " + std::to_string(thread_count) + " threads")
+            {
+                parallel_for(pool, data, work);
+            };
+        }
+
+#ifdef HAS_PARALLEL_STL
+        BENCHMARK("std::for_each(std::execution::par)")
+        {
+            std::for_each(std::execution::par, data.begin(), data.end(), work);
+        };
+#endif
+    }
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <type_traits>
+
+#include "simd_find.hpp"
+
+namespace Sentinels
+{
+    // end of a range is marked with a value stored in the range (like '\0' for C-strings)
+    template <auto Value>
+    struct until_value
+    {
+        static constexpr auto value = Value;
+
+        template <std::input_iterator TIterator>
+        friend bool operator==(const TIterator& it, until_value)
+        {
+            return *it == Value;
+        }
+    };
+
+    template <typename T>
+    constexpr bool is_until_value = false;
+
+    template <auto Value>
+    constexpr bool is_until_value<until_value<Value>> = true;
+
+    // iterator to the terminator - contiguous items of the same type as the value are searched with SIMD
+    // - with limit the search may stop earlier: after at least limit items (but never past the terminator)
+    template <std::input_iterator TIterator, auto Value>
+    TIterator find_end(TIterator first, until_value<Value> sentinel, std::size_t limit = std::numeric_limits<std::size_t>::max())
+    {
+        if constexpr (std::contiguous_iterator<TIterator> && std::is_same_v<std::iter_value_t<TIterator>, decltype(Value)>)
+        {
+            const auto* ptr = std::to_address(first);
+            return first + (Simd::find_terminator(ptr, Value, limit) - ptr);
+        }
+        else
+        {
+            for (; limit != 0 && first != sentinel; --limit)
+                ++first;
+
+            return first;
+        }
+    }
+
+    // items scanned for the terminator & then processed while they are still in L1 cache
+    constexpr std::size_t window_size = 4096;
+
+    // calls process(window_first, window_last) for consecutive parts of the range - one pass over memory
+    // instead of a terminator scan followed by a second pass; stops when process returns false
+    template <std::contiguous_iterator TIterator, auto Value, typename TProcess>
+    void for_each_window(TIterator first, until_value<Value> sentinel, TProcess process)
+    {
+        for (;;)
+        {
+            const TIterator window_end = find_end(first, sentinel, window_size);
+
+            if (!process(first, window_end) || window_end == sentinel)
+                return;
+
+            first = window_end;
+        }
+    }
+} // namespace Sentinels
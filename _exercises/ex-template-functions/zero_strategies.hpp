@@ -0,0 +1,87 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <immintrin.h>
+#define ZEROING_STREAMING_STORES
+#endif
+
+#include "parallel_accumulate.hpp"
+
+// Size-based strategies for zeroing large buffers
+namespace Zeroing
+{
+    struct Thresholds
+    {
+        std::size_t streaming_bytes = 8 * 1024 * 1024;   // from this size stores bypass the cache (buffer is not read soon)
+        std::size_t parallel_bytes = 128 * 1024 * 1024;  // from this size buffer is split between threads
+        Execution::ParallelPolicy parallel_policy{};
+    };
+
+    // tunable at runtime - should not be modified while buffers are being zeroed
+    inline Thresholds thresholds{};
+
+    // non-temporal stores - written cache lines do not evict the working set of the program
+    inline void zero_streaming(void* ptr, std::size_t bytes)
+    {
+#ifdef ZEROING_STREAMING_STORES
+        auto* first = static_cast<std::byte*>(ptr);
+        auto* last = first + bytes;
+
+        constexpr std::size_t alignment = 64;
+        auto* aligned_first = reinterpret_cast<std::byte*>((reinterpret_cast<std::uintptr_t>(first) + alignment - 1) & ~(alignment - 1));
+        auto* aligned_last = reinterpret_cast<std::byte*>(reinterpret_cast<std::uintptr_t>(last) & ~(alignment - 1));
+
+        if (aligned_first >= aligned_last)
+        {
+            std::memset(ptr, 0, bytes);
+            return;
+        }
+
+        std::memset(first, 0, aligned_first - first);
+
+        const __m128i zeros = _mm_setzero_si128();
+        for (auto* line = aligned_first; line != aligned_last; line += alignment)
+        {
+            _mm_stream_si128(reinterpret_cast<__m128i*>(line), zeros);
+            _mm_stream_si128(reinterpret_cast<__m128i*>(line + 16), zeros);
+            _mm_stream_si128(reinterpret_cast<__m128i*>(line + 32), zeros);
+            _mm_stream_si128(reinterpret_cast<__m128i*>(line + 48), zeros);
+        }
+        _mm_sfence(); // streaming stores are weakly ordered
+
+        std::memset(aligned_last, 0, last - aligned_last);
+#else
+        std::memset(ptr, 0, bytes);
+#endif
+    }
+
+    // each thread (or task of the pool) zeroes a page-aligned part of the buffer with streaming stores
+    inline void zero_parallel(void* ptr, std::size_t bytes, const Execution::ParallelPolicy& policy)
+    {
+        constexpr std::size_t page_size = 4096;
+
+        const unsigned thread_count = policy.threads();
+        const std::size_t part_size = std::max(page_size, (bytes / thread_count + page_size - 1) / page_size * page_size);
+        const std::size_t part_count = (bytes + part_size - 1) / part_size;
+
+        Parallel::for_each_index(policy, part_count, [=](std::size_t index) {
+            const std::size_t offset = index * part_size;
+            zero_streaming(static_cast<std::byte*>(ptr) + offset, std::min(part_size, bytes - offset));
+        });
+    }
+
+    inline void zero_bytes(void* ptr, std::size_t bytes)
+    {
+        if (bytes < thresholds.streaming_bytes)
+            std::memset(ptr, 0, bytes);
+        else if (bytes < thresholds.parallel_bytes || thresholds.parallel_policy.threads() == 1)
+            zero_streaming(ptr, bytes);
+        else
+            zero_parallel(ptr, bytes, thresholds.parallel_policy);
+    }
+} // namespace Zeroing
@@ -0,0 +1,205 @@
+#pragma once
+
+#include <bit>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <ranges>
+#include <span>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace vt
+{
+    namespace Hashing
+    {
+        // wyhash constants - odd, with balanced bits
+        inline constexpr std::uint64_t secret[4] = {0xa0761d6478bd642full, 0xe7037ed1a0b428dbull, 0x8ebc6af09c88c6e3ull, 0x589965cc75374cc3ull};
+
+        // 64x64 -> 128 bit multiplication - a and b are replaced with the low and high halves of the product
+        constexpr void mum(std::uint64_t& a, std::uint64_t& b)
+        {
+#if defined(__SIZEOF_INT128__)
+            const unsigned __int128 product = static_cast<unsigned __int128>(a) * b;
+            a = static_cast<std::uint64_t>(product);
+            b = static_cast<std::uint64_t>(product >> 64);
+#else
+            const std::uint64_t a_low = a & 0xffffffff, a_high = a >> 32;
+            const std::uint64_t b_low = b & 0xffffffff, b_high = b >> 32;
+            const std::uint64_t low_low = a_low * b_low, low_high = a_low * b_high, high_low = a_high * b_low, high_high = a_high * b_high;
+            const std::uint64_t middle = (low_low >> 32) + (low_high & 0xffffffff) + (high_low & 0xffffffff);
+            a = (middle << 32) | (low_low & 0xffffffff);
+            b = high_high + (low_high >> 32) + (high_low >> 32) + (middle >> 32);
+#endif
+        }
+
+        // the product folded to 64 bits - every input bit affects most of the output bits
+        constexpr std::uint64_t mix(std::uint64_t a, std::uint64_t b)
+        {
+            mum(a, b);
+            return a ^ b;
+        }
+
+        inline std::uint64_t read8(const unsigned char* p)
+        {
+            std::uint64_t value;
+            std::memcpy(&value, p, sizeof(value));
+            return value;
+        }
+
+        inline std::uint64_t read4(const unsigned char* p)
+        {
+            std::uint32_t value;
+            std::memcpy(&value, p, sizeof(value));
+            return value;
+        }
+
+        // wyhash (final version 4) of a byte sequence
+        inline std::uint64_t hash_bytes(const void* data, std::size_t length, std::uint64_t seed = secret[0])
+        {
+            const auto* p = static_cast<const unsigned char*>(data);
+            seed ^= mix(seed ^ secret[0], secret[1]);
+
+            std::uint64_t a, b;
+            if (length <= 16)
+            {
+                if (length >= 4)
+                {
+                    const std::size_t shift = (length >> 3) << 2;
+                    a = (read4(p) << 32) | read4(p + shift);
+                    b = (read4(p + length - 4) << 32) | read4(p + length - 4 - shift);
+                }
+                else if (length > 0)
+                {
+                    a = (std::uint64_t{p[0]} << 16) | (std::uint64_t{p[length >> 1]} << 8) | p[length - 1];
+                    b = 0;
+                }
+                else
+                {
+                    a = b = 0;
+                }
+            }
+            else
+            {
+                std::size_t left = length;
+                if (left > 48)
+                {
+                    std::uint64_t seed1 = seed, seed2 = seed;
+                    do
+                    {
+                        seed = mix(read8(p) ^ secret[1], read8(p + 8) ^ seed);
+                        seed1 = mix(read8(p + 16) ^ secret[2], read8(p + 24) ^ seed1);
+                        seed2 = mix(read8(p + 32) ^ secret[3], read8(p + 40) ^ seed2);
+                        p += 48;
+                        left -= 48;
+                    } while (left > 48);
+                    seed ^= seed1 ^ seed2;
+                }
+
+                for (; left > 16; left -= 16, p += 16)
+                    seed = mix(read8(p) ^ secret[1], read8(p + 8) ^ seed);
+
+                a = read8(p + left - 16);
+                b = read8(p + left - 8);
+            }
+
+            a ^= secret[1];
+            b ^= seed;
+            mum(a, b);
+            return mix(a ^ secret[0] ^ length, b ^ secret[1]);
+        }
+
+        template <typename T>
+        concept StringLike = std::convertible_to<const T&, std::string_view>;
+
+        // 64-bit value representing the argument - strings are hashed, numbers are used directly (mixing is done later)
+        template <typename T>
+        std::uint64_t hash_value(const T& value)
+        {
+            if constexpr (StringLike<T>)
+            {
+                const std::string_view text = value;
+                return hash_bytes(text.data(), text.size());
+            }
+            else if constexpr (std::is_integral_v<T> || std::is_enum_v<T>)
+            {
+                return static_cast<std::uint64_t>(value);
+            }
+            else if constexpr (std::is_floating_point_v<T> && sizeof(T) <= sizeof(std::uint64_t))
+            {
+                const double number = value == 0 ? 0.0 : static_cast<double>(value); // -0.0 == 0.0
+                return std::bit_cast<std::uint64_t>(number);
+            }
+            else if constexpr (std::is_pointer_v<T>)
+            {
+                return reinterpret_cast<std::uintptr_t>(value);
+            }
+            else
+            {
+                return std::hash<T>{}(value);
+            }
+        }
+
+        // seed is xor-ed back - a zero product (value == secret[2]) does not erase the previous arguments
+        constexpr std::uint64_t combine(std::uint64_t seed, std::uint64_t value)
+        {
+            return seed ^ mix(seed ^ secret[1], value ^ secret[2]);
+        }
+
+        constexpr std::uint64_t finalize(std::uint64_t seed, std::size_t count)
+        {
+            return mix(seed ^ secret[3], count ^ secret[0]);
+        }
+    } // namespace Hashing
+
+    // 64-bit hash of all the arguments (order matters) - suitable for composite keys of hash tables
+    template <typename... Ts>
+    std::uint64_t combined_hash(const Ts&... args)
+    {
+        std::uint64_t seed = Hashing::secret[0];
+        ((seed = Hashing::combine(seed, Hashing::hash_value(args))), ...);
+        return Hashing::finalize(seed, sizeof...(Ts));
+    }
+
+    // hashes[i] = combined_hash of the elements of keys[i] (tuple, pair or array)
+    // - 4 keys are hashed in lockstep, so their multiplication chains overlap in the pipeline
+    //   (64x64 -> 128 bit multiplication has no SSE/AVX2 instruction - the lanes are scalar registers)
+    template <std::ranges::contiguous_range TKeys>
+    void hash_batch(const TKeys& keys, std::span<std::uint64_t> hashes)
+    {
+        using Key = std::ranges::range_value_t<TKeys>;
+        using namespace Hashing;
+
+        const Key* items = std::ranges::data(keys);
+        const std::size_t count = std::ranges::size(keys);
+        assert(hashes.size() >= count);
+
+        auto hash_4_keys = [&]<std::size_t... Is>(const Key* key, std::uint64_t* out, std::index_sequence<Is...>) {
+            std::uint64_t seed0 = secret[0], seed1 = secret[0], seed2 = secret[0], seed3 = secret[0];
+
+            // field by field - a step of every lane before the next field
+            ((seed0 = combine(seed0, hash_value(std::get<Is>(key[0]))),
+                 seed1 = combine(seed1, hash_value(std::get<Is>(key[1]))),
+                 seed2 = combine(seed2, hash_value(std::get<Is>(key[2]))),
+                 seed3 = combine(seed3, hash_value(std::get<Is>(key[3])))),
+                ...);
+
+            out[0] = finalize(seed0, sizeof...(Is));
+            out[1] = finalize(seed1, sizeof...(Is));
+            out[2] = finalize(seed2, sizeof...(Is));
+            out[3] = finalize(seed3, sizeof...(Is));
+        };
+
+        std::size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+            hash_4_keys(items + i, hashes.data() + i, std::make_index_sequence<std::tuple_size_v<Key>>{});
+
+        for (; i < count; ++i)
+            hashes[i] = std::apply([](const auto&... args) { return combined_hash(args...); }, items[i]);
+    }
+} // namespace vt
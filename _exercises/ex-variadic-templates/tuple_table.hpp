@@ -0,0 +1,649 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__AVX2__) || defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <immintrin.h>
+#define TUPLE_TABLE_SSE2
+#endif
+
+#if defined(__AVX2__)
+#define TUPLE_TABLE_AVX2
+#endif
+
+namespace vt
+{
+    // Set of selected rows of a table - one bit per row (bits past size() are always 0)
+    class Selection
+    {
+        static constexpr std::size_t word_size = 64;
+
+        std::vector<std::uint64_t> bits;
+        std::size_t item_count = 0;
+
+    public:
+        Selection() = default;
+
+        explicit Selection(std::size_t size, bool selected = false)
+            : bits((size + word_size - 1) / word_size, selected ? ~std::uint64_t{0} : 0)
+            , item_count{size}
+        {
+            if (selected && size % word_size != 0)
+                bits.back() >>= word_size - size % word_size;
+        }
+
+        // selection of the items satisfying pred - a word of 64 items is evaluated without branches
+        template <typename T, typename TPredicate>
+        static Selection matching(std::span<const T> items, TPredicate pred)
+        {
+            Selection selection(items.size());
+            const std::size_t full_words = items.size() / word_size;
+
+            for (std::size_t w = 0; w < full_words; ++w)
+            {
+                const T* block = items.data() + w * word_size;
+                std::uint64_t word = 0;
+                for (std::size_t j = 0; j < word_size; ++j)
+                    word |= std::uint64_t{static_cast<bool>(pred(block[j]))} << j;
+                selection.bits[w] = word;
+            }
+
+            for (std::size_t i = full_words * word_size; i < items.size(); ++i)
+                selection.set(i, static_cast<bool>(pred(items[i])));
+
+            return selection;
+        }
+
+        std::size_t size() const
+        {
+            return item_count;
+        }
+
+        // number of selected items
+        std::size_t count() const
+        {
+            std::size_t result = 0;
+            for (std::uint64_t word : bits)
+                result += static_cast<std::size_t>(std::popcount(word));
+            return result;
+        }
+
+        bool test(std::size_t index) const
+        {
+            assert(index < item_count);
+            return (bits[index / word_size] >> (index % word_size)) & 1;
+        }
+
+        void set(std::size_t index, bool selected = true)
+        {
+            assert(index < item_count);
+            const std::uint64_t mask = std::uint64_t{1} << (index % word_size);
+            bits[index / word_size] = selected ? bits[index / word_size] | mask : bits[index / word_size] & ~mask;
+        }
+
+        // bit i % 64 of word i / 64 is set when item i is selected
+        std::span<const std::uint64_t> words() const
+        {
+            return bits;
+        }
+
+        // calls f(index) for every selected item in ascending order
+        template <typename TFunction>
+        void for_each(TFunction f) const
+        {
+            for (std::size_t w = 0; w < bits.size(); ++w)
+            {
+                for (std::uint64_t word = bits[w]; word != 0; word &= word - 1)
+                    f(w * word_size + static_cast<std::size_t>(std::countr_zero(word)));
+            }
+        }
+
+        Selection& operator&=(const Selection& other)
+        {
+            assert(item_count == other.item_count);
+            for (std::size_t w = 0; w < bits.size(); ++w)
+                bits[w] &= other.bits[w];
+            return *this;
+        }
+
+        Selection& operator|=(const Selection& other)
+        {
+            assert(item_count == other.item_count);
+            for (std::size_t w = 0; w < bits.size(); ++w)
+                bits[w] |= other.bits[w];
+            return *this;
+        }
+
+        Selection& operator^=(const Selection& other)
+        {
+            assert(item_count == other.item_count);
+            for (std::size_t w = 0; w < bits.size(); ++w)
+                bits[w] ^= other.bits[w];
+            return *this;
+        }
+
+        friend Selection operator&(Selection a, const Selection& b)
+        {
+            return a &= b;
+        }
+
+        friend Selection operator|(Selection a, const Selection& b)
+        {
+            return a |= b;
+        }
+
+        friend Selection operator~(Selection a)
+        {
+            return a ^= Selection(a.item_count, true);
+        }
+
+        bool operator==(const Selection&) const = default;
+    };
+
+    // Aggregates of columns restricted to a selection (nullptr selects all items)
+    namespace Columns
+    {
+        // integers are summed in 64 bits
+        template <typename T>
+        using SumType = std::conditional_t<std::is_integral_v<T>, std::conditional_t<std::is_signed_v<T>, std::int64_t, std::uint64_t>, T>;
+
+        // calls f(index) for the selected items in [first; last)
+        template <typename TFunction>
+        void for_each_selected(const Selection* selection, std::size_t first, std::size_t last, TFunction f)
+        {
+            if (!selection)
+            {
+                for (std::size_t i = first; i < last; ++i)
+                    f(i);
+                return;
+            }
+
+            const std::span<const std::uint64_t> words = selection->words();
+            for (std::size_t w = first / 64; w * 64 < last; ++w)
+            {
+                std::uint64_t word = words[w];
+                if (w == first / 64)
+                    word &= ~std::uint64_t{0} << (first % 64);
+
+                for (; word != 0; word &= word - 1)
+                    f(w * 64 + static_cast<std::size_t>(std::countr_zero(word)));
+            }
+        }
+
+        // calls f(index, lanes) for the blocks of width items containing selected items (lanes - bit mask of the selected items);
+        // returns the number of items covered by the blocks - the rest (less than width items) is left for scalar code
+        template <std::size_t width, typename TFunction>
+        std::size_t for_each_selected_block(const Selection* selection, std::size_t size, TFunction f)
+        {
+            static_assert(64 % width == 0);
+            constexpr unsigned all_lanes = (1u << width) - 1;
+
+            const std::size_t vectorized_size = size - size % width;
+
+            for (std::size_t first = 0; first < vectorized_size; first += 64)
+            {
+                const std::uint64_t word = selection ? selection->words()[first / 64] : ~std::uint64_t{0};
+                if (word == 0)
+                    continue;
+
+                const std::size_t last = std::min(first + 64, vectorized_size);
+                for (std::size_t i = first; i < last; i += width)
+                    f(i, static_cast<unsigned>(word >> (i - first)) & all_lanes);
+            }
+
+            return vectorized_size;
+        }
+
+        namespace Kernels
+        {
+            // sets of operations on vector registers used by the vectorized aggregates
+            // - lanes(bits) - mask of the lanes whose bits are set
+            // - min/max(value, acc) - value if it is less/greater than acc, acc otherwise
+
+#ifdef TUPLE_TABLE_AVX2
+            struct Avx2Int32
+            {
+                using value_type = std::int32_t;
+                using sum_type = std::int64_t;
+                using vector = __m256i;
+                using sum_vector = __m256i;
+                static constexpr std::size_t width = 8;
+
+                static vector load(const value_type* ptr) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr)); }
+                static vector broadcast(value_type value) { return _mm256_set1_epi32(value); }
+                static vector lanes(unsigned bits)
+                {
+                    const __m256i lane_bits = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+                    return _mm256_cmpeq_epi32(_mm256_and_si256(_mm256_set1_epi32(static_cast<int>(bits)), lane_bits), lane_bits);
+                }
+                static vector select(vector mask, vector a, vector b) { return _mm256_blendv_epi8(b, a, mask); }
+                static vector min(vector value, vector acc) { return _mm256_min_epi32(value, acc); }
+                static vector max(vector value, vector acc) { return _mm256_max_epi32(value, acc); }
+                static void store(value_type* ptr, vector a) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(ptr), a); }
+
+                static sum_vector zero_sum() { return _mm256_setzero_si256(); }
+                static sum_vector add(sum_vector acc, vector a)
+                {
+                    acc = _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(a)));
+                    return _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(a, 1)));
+                }
+                static sum_type total(sum_vector acc)
+                {
+                    alignas(32) std::int64_t parts[4];
+                    _mm256_store_si256(reinterpret_cast<__m256i*>(parts), acc);
+                    return parts[0] + parts[1] + parts[2] + parts[3];
+                }
+            };
+
+            struct Avx2Double
+            {
+                using value_type = double;
+                using sum_type = double;
+                using vector = __m256d;
+                using sum_vector = __m256d;
+                static constexpr std::size_t width = 4;
+
+                static vector load(const value_type* ptr) { return _mm256_loadu_pd(ptr); }
+                static vector broadcast(value_type value) { return _mm256_set1_pd(value); }
+                static vector lanes(unsigned bits)
+                {
+                    const __m256i lane_bits = _mm256_setr_epi64x(1, 2, 4, 8);
+                    return _mm256_castsi256_pd(_mm256_cmpeq_epi64(_mm256_and_si256(_mm256_set1_epi64x(bits), lane_bits), lane_bits));
+                }
+                static vector select(vector mask, vector a, vector b) { return _mm256_blendv_pd(b, a, mask); }
+                static vector min(vector value, vector acc) { return _mm256_min_pd(value, acc); }
+                static vector max(vector value, vector acc) { return _mm256_max_pd(value, acc); }
+                static void store(value_type* ptr, vector a) { _mm256_storeu_pd(ptr, a); }
+
+                static sum_vector zero_sum() { return _mm256_setzero_pd(); }
+                static sum_vector add(sum_vector acc, vector a) { return _mm256_add_pd(acc, a); }
+                static sum_type total(sum_vector acc)
+                {
+                    alignas(32) double parts[4];
+                    _mm256_store_pd(parts, acc);
+                    return (parts[0] + parts[1]) + (parts[2] + parts[3]);
+                }
+            };
+#endif
+
+#ifdef TUPLE_TABLE_SSE2
+            struct Sse2Int32
+            {
+                using value_type = std::int32_t;
+                using sum_type = std::int64_t;
+                using vector = __m128i;
+                using sum_vector = __m128i;
+                static constexpr std::size_t width = 4;
+
+                static vector load(const value_type* ptr) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr)); }
+                static vector broadcast(value_type value) { return _mm_set1_epi32(value); }
+                static vector lanes(unsigned bits)
+                {
+                    const __m128i lane_bits = _mm_setr_epi32(1, 2, 4, 8);
+                    return _mm_cmpeq_epi32(_mm_and_si128(_mm_set1_epi32(static_cast<int>(bits)), lane_bits), lane_bits);
+                }
+                static vector select(vector mask, vector a, vector b) { return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b)); }
+                static vector min(vector value, vector acc) { return select(_mm_cmplt_epi32(value, acc), value, acc); }
+                static vector max(vector value, vector acc) { return select(_mm_cmpgt_epi32(value, acc), value, acc); }
+                static void store(value_type* ptr, vector a) { _mm_storeu_si128(reinterpret_cast<__m128i*>(ptr), a); }
+
+                static sum_vector zero_sum() { return _mm_setzero_si128(); }
+                static sum_vector add(sum_vector acc, vector a)
+                {
+                    // sign extension to 64 bits - SSE2 has no pmovsxdq
+                    const __m128i sign = _mm_srai_epi32(a, 31);
+                    acc = _mm_add_epi64(acc, _mm_unpacklo_epi32(a, sign));
+                    return _mm_add_epi64(acc, _mm_unpackhi_epi32(a, sign));
+                }
+                static sum_type total(sum_vector acc)
+                {
+                    alignas(16) std::int64_t parts[2];
+                    _mm_store_si128(reinterpret_cast<__m128i*>(parts), acc);
+                    return parts[0] + parts[1];
+                }
+            };
+
+            struct Sse2Double
+            {
+                using value_type = double;
+                using sum_type = double;
+                using vector = __m128d;
+                using sum_vector = __m128d;
+                static constexpr std::size_t width = 2;
+
+                static vector load(const value_type* ptr) { return _mm_loadu_pd(ptr); }
+                static vector broadcast(value_type value) { return _mm_set1_pd(value); }
+                static vector lanes(unsigned bits)
+                {
+                    // 32-bit comparison of the low halves of 64-bit lanes - the result is copied to the high halves
+                    const __m128i lane_bits = _mm_setr_epi32(1, 0, 2, 0);
+                    const __m128i mask = _mm_cmpeq_epi32(_mm_and_si128(_mm_set1_epi32(static_cast<int>(bits)), lane_bits), lane_bits);
+                    return _mm_castsi128_pd(_mm_shuffle_epi32(mask, _MM_SHUFFLE(2, 2, 0, 0)));
+                }
+                static vector select(vector mask, vector a, vector b) { return _mm_or_pd(_mm_and_pd(mask, a), _mm_andnot_pd(mask, b)); }
+                static vector min(vector value, vector acc) { return _mm_min_pd(value, acc); }
+                static vector max(vector value, vector acc) { return _mm_max_pd(value, acc); }
+                static void store(value_type* ptr, vector a) { _mm_storeu_pd(ptr, a); }
+
+                static sum_vector zero_sum() { return _mm_setzero_pd(); }
+                static sum_vector add(sum_vector acc, vector a) { return _mm_add_pd(acc, a); }
+                static sum_type total(sum_vector acc)
+                {
+                    alignas(16) double parts[2];
+                    _mm_store_pd(parts, acc);
+                    return parts[0] + parts[1];
+                }
+            };
+#endif
+
+            template <typename T>
+            struct Vectorized
+            {
+                using type = void;
+            };
+
+#if defined(TUPLE_TABLE_AVX2)
+            template <>
+            struct Vectorized<std::int32_t>
+            {
+                using type = Avx2Int32;
+            };
+
+            template <>
+            struct Vectorized<double>
+            {
+                using type = Avx2Double;
+            };
+#elif defined(TUPLE_TABLE_SSE2)
+            template <>
+            struct Vectorized<std::int32_t>
+            {
+                using type = Sse2Int32;
+            };
+
+            template <>
+            struct Vectorized<double>
+            {
+                using type = Sse2Double;
+            };
+#endif
+
+            template <typename TOps>
+            typename TOps::sum_type sum_vectorized(std::span<const typename TOps::value_type> items, const Selection* selection)
+            {
+                typename TOps::sum_vector acc = TOps::zero_sum();
+                const typename TOps::vector zero = TOps::broadcast(0);
+
+                const std::size_t vectorized_size = for_each_selected_block<TOps::width>(selection, items.size(), [&](std::size_t i, unsigned bits) {
+                    acc = TOps::add(acc, TOps::select(TOps::lanes(bits), TOps::load(items.data() + i), zero));
+                });
+
+                typename TOps::sum_type result = TOps::total(acc);
+                for_each_selected(selection, vectorized_size, items.size(), [&](std::size_t i) { result += items[i]; });
+                return result;
+            }
+
+            // minimum (is_max == false) or maximum of the selected items - at least one item must be selected
+            template <typename TOps, bool is_max>
+            typename TOps::value_type extremum_vectorized(std::span<const typename TOps::value_type> items, const Selection* selection)
+            {
+                using value_type = typename TOps::value_type;
+
+                // infinities - a selection of only +inf (for min) or -inf (for max) must not return max() / lowest()
+                using limits = std::numeric_limits<value_type>;
+                constexpr value_type largest = limits::has_infinity ? limits::infinity() : limits::max();
+                constexpr value_type smallest = limits::has_infinity ? -limits::infinity() : limits::lowest();
+                const value_type identity = is_max ? smallest : largest;
+                const typename TOps::vector identities = TOps::broadcast(identity);
+                typename TOps::vector acc = identities;
+
+                const std::size_t vectorized_size = for_each_selected_block<TOps::width>(selection, items.size(), [&](std::size_t i, unsigned bits) {
+                    const typename TOps::vector values = TOps::select(TOps::lanes(bits), TOps::load(items.data() + i), identities);
+                    acc = is_max ? TOps::max(values, acc) : TOps::min(values, acc);
+                });
+
+                value_type parts[TOps::width];
+                TOps::store(parts, acc);
+
+                value_type result = identity;
+                auto update = [&result](const value_type& value) {
+                    if (is_max ? result < value : value < result)
+                        result = value;
+                };
+
+                for (const value_type& part : parts)
+                    update(part);
+                for_each_selected(selection, vectorized_size, items.size(), [&](std::size_t i) { update(items[i]); });
+
+                return result;
+            }
+        } // namespace Kernels
+
+        template <typename T>
+        SumType<T> sum(std::span<const T> items, const Selection* selection = nullptr)
+        {
+            assert(!selection || selection->size() == items.size());
+
+            using TOps = typename Kernels::Vectorized<T>::type;
+
+            if constexpr (!std::is_void_v<TOps>)
+                return Kernels::sum_vectorized<TOps>(items, selection);
+            else
+            {
+                SumType<T> result{};
+                for_each_selected(selection, 0, items.size(), [&](std::size_t i) { result += items[i]; });
+                return result;
+            }
+        }
+
+        // nullopt when no item is selected
+        template <bool is_max, typename T>
+        std::optional<T> extremum(std::span<const T> items, const Selection* selection = nullptr)
+        {
+            assert(!selection || selection->size() == items.size());
+
+            if (selection ? selection->count() == 0 : items.empty())
+                return std::nullopt;
+
+            using TOps = typename Kernels::Vectorized<T>::type;
+
+            if constexpr (!std::is_void_v<TOps>)
+                return Kernels::extremum_vectorized<TOps, is_max>(items, selection);
+            else
+            {
+                const T* result = nullptr;
+                for_each_selected(selection, 0, items.size(), [&](std::size_t i) {
+                    if (!result || (is_max ? *result < items[i] : items[i] < *result))
+                        result = &items[i];
+                });
+                return *result;
+            }
+        }
+
+        template <typename T>
+        std::optional<T> min(std::span<const T> items, const Selection* selection = nullptr)
+        {
+            return extremum<false>(items, selection);
+        }
+
+        template <typename T>
+        std::optional<T> max(std::span<const T> items, const Selection* selection = nullptr)
+        {
+            return extremum<true>(items, selection);
+        }
+    } // namespace Columns
+
+    // Columnar store of tuples - every element type is kept in its own contiguous column,
+    // so an operation on a few columns does not touch the memory of the others
+    template <typename... Ts>
+    class TupleTable
+    {
+        std::tuple<std::vector<Ts>...> columns;
+
+        template <typename TColumnFunction>
+        void for_each_column(TColumnFunction f)
+        {
+            std::apply([&f](auto&... column) { (f(column), ...); }, columns);
+        }
+
+        template <typename... TValues, std::size_t... Is>
+        void append_values(std::index_sequence<Is...>, TValues&&... values)
+        {
+            const std::size_t old_size = size();
+
+            try
+            {
+                (std::get<Is>(columns).push_back(std::forward<TValues>(values)), ...);
+            }
+            catch (...)
+            {
+                // keeps columns of equal length
+                for_each_column([old_size](auto& column) { column.erase(column.begin() + old_size, column.end()); });
+                throw;
+            }
+        }
+
+        template <typename TTable, std::size_t... Is>
+        static auto select_columns(TTable& table)
+        {
+            return std::views::iota(std::size_t{0}, table.size())
+                | std::views::transform([&table](std::size_t index) { return std::tie(std::get<Is>(table.columns)[index]...); });
+        }
+
+    public:
+        using row_type = std::tuple<Ts...>;
+
+        template <std::size_t I>
+        using column_type = std::tuple_element_t<I, row_type>;
+
+        std::size_t size() const
+        {
+            return std::get<0>(columns).size();
+        }
+
+        bool empty() const
+        {
+            return size() == 0;
+        }
+
+        void reserve(std::size_t capacity)
+        {
+            for_each_column([capacity](auto& column) { column.reserve(capacity); });
+        }
+
+        void clear()
+        {
+            for_each_column([](auto& column) { column.clear(); });
+        }
+
+        template <typename... TValues>
+            requires(sizeof...(TValues) == sizeof...(Ts) && (std::constructible_from<Ts, TValues &&> && ...))
+        void append(TValues&&... values)
+        {
+            append_values(std::index_sequence_for<Ts...>{}, std::forward<TValues>(values)...);
+        }
+
+        void append(const row_type& row)
+        {
+            std::apply([this](const auto&... values) { append(values...); }, row);
+        }
+
+        void append(row_type&& row)
+        {
+            std::apply([this](auto&&... values) { append(std::move(values)...); }, std::move(row));
+        }
+
+        template <std::size_t I>
+        std::span<column_type<I>> column()
+        {
+            return std::get<I>(columns);
+        }
+
+        template <std::size_t I>
+        std::span<const column_type<I>> column() const
+        {
+            return std::get<I>(columns);
+        }
+
+        std::tuple<Ts&...> row(std::size_t index)
+        {
+            return std::apply([index](auto&... column) { return std::tie(column[index]...); }, columns);
+        }
+
+        std::tuple<const Ts&...> row(std::size_t index) const
+        {
+            return std::apply([index](const auto&... column) { return std::tie(column[index]...); }, columns);
+        }
+
+        // rows whose item in column I satisfies pred - selections can be combined with &, | and ~
+        template <std::size_t I, typename TPredicate>
+        Selection filter(TPredicate pred) const
+        {
+            return Selection::matching(column<I>(), pred);
+        }
+
+        // sum of column I (integers are summed in 64 bits) - vectorized for int32 & double columns
+        template <std::size_t I>
+        Columns::SumType<column_type<I>> sum() const
+        {
+            return Columns::sum(column<I>());
+        }
+
+        template <std::size_t I>
+        Columns::SumType<column_type<I>> sum(const Selection& selection) const
+        {
+            return Columns::sum(column<I>(), &selection);
+        }
+
+        // minimum of column I or nullopt when no row is selected
+        template <std::size_t I>
+        std::optional<column_type<I>> min() const
+        {
+            return Columns::min(column<I>());
+        }
+
+        template <std::size_t I>
+        std::optional<column_type<I>> min(const Selection& selection) const
+        {
+            return Columns::min(column<I>(), &selection);
+        }
+
+        template <std::size_t I>
+        std::optional<column_type<I>> max() const
+        {
+            return Columns::max(column<I>());
+        }
+
+        template <std::size_t I>
+        std::optional<column_type<I>> max(const Selection& selection) const
+        {
+            return Columns::max(column<I>(), &selection);
+        }
+
+        // zero-copy projection - random access view of tuples of references to the items of the selected columns
+        // (valid until the table is modified)
+        template <std::size_t... Is>
+        auto select()
+        {
+            return select_columns<TupleTable, Is...>(*this);
+        }
+
+        template <std::size_t... Is>
+        auto select() const
+        {
+            return select_columns<const TupleTable, Is...>(*this);
+        }
+    };
+} // namespace vt
@@ -1,10 +1,30 @@
 #include <algorithm>
+#include <array>
 #include <cassert>
 #include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_approx.hpp>
 #include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
 #include <iostream>
+#include <limits>
+#include <memory>
+#include <new>
+#include <numeric>
+#include <random>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
 #include <type_traits>
+#include <unordered_set>
+#include <vector>
+
+#include "combined_hash.hpp"
+#include "static_vector.hpp"
+#include "tuple_table.hpp"
 
 using namespace std;
 
@@ -44,16 +64,346 @@ TEST_CASE("variadic sum")
 
 namespace vt
 {
-    // TODO - implement select function that returns tuple with selected elements
+    // tuple with copies of the selected elements
+    template <size_t... Is, typename TTuple>
+    auto select(const TTuple& row)
+    {
+        return std::make_tuple(std::get<Is>(row)...);
+    }
+
+    // tuple of references to the selected elements - no copies
+    template <size_t... Is, typename TTuple>
+    auto select_ref(TTuple& row)
+    {
+        return std::tie(std::get<Is>(row)...);
+    }
+
+    // lazy projection of a range of tuples - rows are not copied, the view yields tuples of references
+    template <size_t... Is, std::ranges::viewable_range TRows>
+    auto select_view(TRows&& rows)
+    {
+        return std::views::transform(std::forward<TRows>(rows), [](auto& row) { return select_ref<Is...>(row); });
+    }
 } // namespace vt
 
 TEST_CASE("select for tuple")
 {
-    // std::tuple<int, std::string, std::string, std::vector<int>> row{1, "first-name", "last-name", std::vector<int>{1, 2, 3}};
+    std::tuple<int, std::string, std::string, std::vector<int>> row{1, "first-name", "last-name", std::vector<int>{1, 2, 3}};
+
+    REQUIRE(vt::select<0, 2, 3>(row) == std::make_tuple(1, "last-name", std::vector{1, 2, 3}));
+    REQUIRE(vt::select<0, 0, 0>(row) == std::tuple(1, 1, 1));
+    REQUIRE(vt::select<3, 2, 1, 0>(row) == std::make_tuple(std::vector{1, 2, 3}, "last-name", "first-name", 1));
+
+    SECTION("select_ref returns references")
+    {
+        auto [id, last_name] = vt::select_ref<0, 2>(row);
+        static_assert(std::is_same_v<decltype(vt::select_ref<0, 2>(row)), std::tuple<int&, std::string&>>);
+
+        last_name = "other-name";
+        REQUIRE(std::get<2>(row) == "other-name");
+        REQUIRE(&id == &std::get<0>(row));
+
+        const auto& const_row = row;
+        static_assert(std::is_same_v<decltype(vt::select_ref<1>(const_row)), std::tuple<const std::string&>>);
+    }
+
+    SECTION("select_view projects a range of rows lazily")
+    {
+        std::vector<decltype(row)> rows{row, {2, "jan", "kowalski", {}}};
+
+        auto ids_and_names = vt::select_view<0, 2>(rows);
+        REQUIRE(std::ranges::size(ids_and_names) == 2);
+        REQUIRE(ids_and_names[1] == std::make_tuple(2, "kowalski"));
+
+        std::get<1>(ids_and_names[1]) = "nowak";
+        REQUIRE(std::get<2>(rows[1]) == "nowak");
+    }
+}
+
+TEST_CASE("TupleTable - columnar storage of tuples")
+{
+    vt::TupleTable<int, std::string, std::string, std::vector<int>> table;
+    table.append(1, "jan", "kowalski", std::vector{1, 2, 3});
+    table.append(std::tuple{2, "adam"s, "nowak"s, std::vector{4}});
+
+    REQUIRE(table.size() == 2);
+    REQUIRE(table.row(0) == std::make_tuple(1, "jan", "kowalski", std::vector{1, 2, 3}));
+    REQUIRE(std::ranges::equal(table.column<0>(), std::vector{1, 2}));
+
+    SECTION("select yields references to the selected columns only")
+    {
+        auto ids_and_names = table.select<0, 2>();
+        static_assert(std::ranges::random_access_range<decltype(ids_and_names)>);
+        static_assert(std::is_same_v<std::ranges::range_reference_t<decltype(ids_and_names)>, std::tuple<int&, std::string&>>);
+
+        REQUIRE(std::ranges::size(ids_and_names) == 2);
+        REQUIRE(ids_and_names[1] == std::make_tuple(2, "nowak"));
+        REQUIRE(&std::get<1>(ids_and_names[0]) == &table.column<2>()[0]);
+
+        for (auto [id, last_name] : ids_and_names)
+            last_name += "-" + std::to_string(id);
+        REQUIRE(table.column<2>()[1] == "nowak-2");
+    }
+
+    SECTION("select on const table")
+    {
+        const auto& const_table = table;
+        auto names = const_table.select<2, 1>();
+        static_assert(std::is_same_v<std::ranges::range_reference_t<decltype(names)>, std::tuple<const std::string&, const std::string&>>);
+        REQUIRE(names[0] == std::make_tuple("kowalski", "jan"));
+    }
+
+    SECTION("failed append leaves columns of equal length")
+    {
+        struct Throwing
+        {
+            Throwing(int) { throw std::runtime_error("ctor"); }
+        };
+
+        vt::TupleTable<std::string, Throwing> throwing_table;
+        REQUIRE_THROWS_AS(throwing_table.append("text", 1), std::runtime_error);
+        REQUIRE(throwing_table.empty());
+        REQUIRE(throwing_table.column<0>().empty());
+    }
+}
+
+TEST_CASE("TupleTable - filter & aggregates")
+{
+    vt::TupleTable<int, double, std::string, short> table;
+
+    std::mt19937_64 rnd{42};
+    std::uniform_int_distribution<int> quantity_distribution{-1000, 1000};
+    std::uniform_real_distribution<double> price_distribution{-100.0, 100.0};
+
+    constexpr size_t count = 64 * 15 + 7; // a partial word & a tail shorter than a vector
+    for (size_t i = 0; i < count; ++i)
+        table.append(quantity_distribution(rnd), price_distribution(rnd), "item-" + std::to_string(i), static_cast<short>(i % 100));
+
+    auto quantities = table.column<0>();
+    auto prices = table.column<1>();
+
+    SECTION("filter sets the bits of matching rows")
+    {
+        vt::Selection positive = table.filter<0>([](int quantity) { return quantity > 0; });
+
+        REQUIRE(positive.size() == count);
+        REQUIRE(positive.count() == static_cast<size_t>(std::ranges::count_if(quantities, [](int quantity) { return quantity > 0; })));
+        for (size_t i = 0; i < count; ++i)
+            REQUIRE(positive.test(i) == (quantities[i] > 0));
+
+        vt::Selection not_positive = ~positive;
+        REQUIRE(not_positive.count() == count - positive.count());
+        REQUIRE((positive & not_positive).count() == 0);
+        REQUIRE((positive | not_positive) == vt::Selection(count, true));
+
+        std::vector<size_t> indexes;
+        positive.for_each([&indexes](size_t index) { indexes.push_back(index); });
+        REQUIRE(indexes.size() == positive.count());
+        REQUIRE(std::ranges::all_of(indexes, [&](size_t index) { return quantities[index] > 0; }));
+        REQUIRE(std::ranges::is_sorted(indexes));
+    }
+
+    SECTION("aggregates over a selection match a row loop")
+    {
+        vt::Selection selection = table.filter<3>([](short group) { return group < 30; }) & table.filter<1>([](double price) { return price > -50.0; });
+
+        int64_t expected_quantity_sum = 0;
+        double expected_price_sum = 0.0;
+        int expected_min_quantity = std::numeric_limits<int>::max();
+        double expected_max_price = std::numeric_limits<double>::lowest();
+        for (size_t i = 0; i < count; ++i)
+        {
+            if (std::get<3>(table.row(i)) < 30 && prices[i] > -50.0)
+            {
+                expected_quantity_sum += quantities[i];
+                expected_price_sum += prices[i];
+                expected_min_quantity = std::min(expected_min_quantity, quantities[i]);
+                expected_max_price = std::max(expected_max_price, prices[i]);
+            }
+        }
+
+        static_assert(std::is_same_v<decltype(table.sum<0>(selection)), int64_t>);
+        REQUIRE(table.sum<0>(selection) == expected_quantity_sum);
+        REQUIRE(table.sum<1>(selection) == Catch::Approx(expected_price_sum));
+        REQUIRE(table.min<0>(selection) == expected_min_quantity);
+        REQUIRE(table.max<1>(selection) == expected_max_price);
+    }
+
+    SECTION("aggregates of whole columns")
+    {
+        REQUIRE(table.sum<0>() == std::accumulate(quantities.begin(), quantities.end(), int64_t{0}));
+        REQUIRE(table.sum<1>() == Catch::Approx(std::accumulate(prices.begin(), prices.end(), 0.0)));
+        REQUIRE(table.sum<3>() == std::accumulate(table.column<3>().begin(), table.column<3>().end(), int64_t{0}));
+        REQUIRE(table.min<0>() == std::ranges::min(quantities));
+        REQUIRE(table.max<0>() == std::ranges::max(quantities));
+        REQUIRE(table.min<1>() == std::ranges::min(prices));
+        REQUIRE(table.max<3>() == 99);
+    }
+
+    SECTION("non-arithmetic columns")
+    {
+        vt::Selection selection(count);
+        selection.set(12);
+        selection.set(100);
+        selection.set(count - 1);
+
+        REQUIRE(table.min<2>(selection) == "item-100");
+        REQUIRE(table.max<2>(selection) == "item-966");
+    }
+
+    SECTION("infinities")
+    {
+        constexpr double infinity = std::numeric_limits<double>::infinity();
+        vt::TupleTable<double> values;
+        for (size_t i = 0; i < 37; ++i) // full vectors & a tail
+            values.append(i % 3 == 0 ? infinity : (i % 3 == 1 ? -infinity : static_cast<double>(i)));
+
+        vt::Selection positive_infinities = values.filter<0>([](double value) { return value == infinity; });
+        vt::Selection negative_infinities = values.filter<0>([](double value) { return value == -infinity; });
+
+        REQUIRE(values.min<0>(positive_infinities) == infinity);
+        REQUIRE(values.max<0>(negative_infinities) == -infinity);
+        REQUIRE(values.min<0>() == -infinity);
+        REQUIRE(values.max<0>() == infinity);
+    }
+
+    SECTION("empty selection")
+    {
+        vt::Selection none = table.filter<0>([](int quantity) { return quantity > 1000; });
+
+        REQUIRE(none.count() == 0);
+        REQUIRE(table.sum<0>(none) == 0);
+        REQUIRE(table.sum<1>(none) == 0.0);
+        REQUIRE_FALSE(table.min<0>(none).has_value());
+        REQUIRE_FALSE(table.max<2>(none).has_value());
+        REQUIRE_FALSE(vt::TupleTable<int>{}.max<0>().has_value());
+    }
+}
+
+TEST_CASE("TupleTable - filter & aggregates vs row loop", "[.][benchmark][TupleTable]")
+{
+    constexpr size_t count = 10'000'000;
+
+    // id, price, name, quantity
+    std::vector<std::tuple<int, double, std::string, int>> rows;
+    vt::TupleTable<int, double, std::string, int> table;
+    rows.reserve(count);
+    table.reserve(count);
+
+    std::mt19937_64 rnd{665};
+    std::uniform_int_distribution<int> quantity_distribution{0, 99};
+    std::uniform_real_distribution<double> price_distribution{1.0, 1000.0};
+    for (size_t i = 0; i < count; ++i)
+    {
+        const int id = static_cast<int>(i);
+        const double price = price_distribution(rnd);
+        const int quantity = quantity_distribution(rnd);
+        rows.emplace_back(id, price, "product-" + std::to_string(i), quantity);
+        table.append(id, price, "product-" + std::to_string(i), quantity);
+    }
+
+    BENCHMARK("vector<tuple> - sum of quantities")
+    {
+        int64_t total = 0;
+        for (const auto& row : rows)
+            total += std::get<3>(row);
+        return total;
+    };
+
+    BENCHMARK("TupleTable - sum of quantities")
+    {
+        return table.sum<3>();
+    };
+
+    BENCHMARK("vector<tuple> - sum & max of prices where quantity < 30")
+    {
+        double total = 0.0;
+        double max_price = std::numeric_limits<double>::lowest();
+        for (const auto& [id, price, name, quantity] : rows)
+        {
+            if (quantity < 30)
+            {
+                total += price;
+                max_price = std::max(max_price, price);
+            }
+        }
+        return total + max_price;
+    };
+
+    BENCHMARK("TupleTable - sum & max of prices where quantity < 30")
+    {
+        vt::Selection selection = table.filter<3>([](int quantity) { return quantity < 30; });
+        return table.sum<1>(selection) + *table.max<1>(selection);
+    };
+
+    vt::Selection selection = table.filter<3>([](int quantity) { return quantity < 30; });
+
+    BENCHMARK("TupleTable - filter only")
+    {
+        return table.filter<3>([](int quantity) { return quantity < 30; }).size();
+    };
 
-    // REQUIRE(vt::select<0, 2, 3>(row) == std::make_tuple(1, "last-name", std::vector{1, 2, 3}));
-    // REQUIRE(vt::select<0, 0, 0>(row) == std::tuple(1, 1, 1));
-    // REQUIRE(vt::select<3, 2, 1, 0>(row) == std::make_tuple(std::vector{1, 2, 3}, "last-name", "first-name", 1));
+    BENCHMARK("TupleTable - sum & max over a ready selection")
+    {
+        return table.sum<1>(selection) + *table.max<1>(selection);
+    };
+}
+
+TEST_CASE("select - projecting 2 of 4 columns", "[.][benchmark][select]")
+{
+    constexpr size_t count = 10'000'000;
+
+    // names longer than the small string buffer - copies allocate
+    std::vector<std::tuple<int, std::string, std::string, std::vector<int>>> rows;
+    vt::TupleTable<int, std::string, std::string, std::vector<int>> table;
+    rows.reserve(count);
+    table.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        const int id = static_cast<int>(i);
+        std::string last_name = "last-name-of-customer-" + std::to_string(i);
+        rows.emplace_back(id, "first-name", last_name, std::vector{id, id});
+        table.append(id, "first-name", std::move(last_name), std::vector{id, id});
+    }
+
+    auto total_length = [](auto&& projection) {
+        size_t total = 0;
+        for (auto&& [id, last_name] : projection)
+            total += last_name.size() + static_cast<size_t>(id & 1);
+        return total;
+    };
+
+    BENCHMARK("vector<tuple> - select (copies)")
+    {
+        size_t total = 0;
+        for (const auto& row : rows)
+        {
+            auto [id, last_name] = vt::select<0, 2>(row);
+            total += last_name.size() + static_cast<size_t>(id & 1);
+        }
+        return total;
+    };
+
+    BENCHMARK("vector<tuple> - select_ref")
+    {
+        size_t total = 0;
+        for (auto& row : rows)
+        {
+            auto [id, last_name] = vt::select_ref<0, 2>(row);
+            total += last_name.size() + static_cast<size_t>(id & 1);
+        }
+        return total;
+    };
+
+    BENCHMARK("vector<tuple> - select_view")
+    {
+        return total_length(vt::select_view<0, 2>(rows));
+    };
+
+    BENCHMARK("TupleTable - select")
+    {
+        return total_length(table.select<0, 2>());
+    };
 }
 
 /////////////////////////////////////////////////
@@ -84,27 +434,209 @@ TEST_CASE("call_n_times wrapper")
 
 namespace vt
 {
-    // TODO - make_vector function that creates vector from a list of arguments
-    // Tip: use std::common_type_t<Ts...> trait
+    // one allocation & every argument forwarded once - std::vector{args...} copies them from an initializer_list
+    // (and does not compile for move-only types)
+    template <typename... Ts>
+        requires(sizeof...(Ts) > 0)
+    constexpr std::vector<std::common_type_t<Ts...>> make_vector(Ts&&... args)
+    {
+        std::vector<std::common_type_t<Ts...>> result;
+        result.reserve(sizeof...(Ts));
+        (result.emplace_back(std::forward<Ts>(args)), ...);
+        return result;
+    }
+
+    // fixed-capacity variants - no heap
+    template <typename... Ts>
+        requires(sizeof...(Ts) > 0)
+    constexpr StaticVector<std::common_type_t<Ts...>, sizeof...(Ts)> make_static_vector(Ts&&... args)
+    {
+        StaticVector<std::common_type_t<Ts...>, sizeof...(Ts)> result;
+        (result.emplace_back(std::forward<Ts>(args)), ...);
+        return result;
+    }
+
+    template <typename... Ts>
+        requires(sizeof...(Ts) > 0)
+    constexpr std::array<std::common_type_t<Ts...>, sizeof...(Ts)> make_array(Ts&&... args)
+    {
+        // explicit conversion - braced initialization rejects narrowing (e.g. int -> double in make_array(1, 2.5))
+        return {static_cast<std::common_type_t<Ts...>>(std::forward<Ts>(args))...};
+    }
 } // namespace vt
 
+namespace AllocationCounting
+{
+    std::size_t allocation_count = 0;
+
+    // counts copies & moves of the items
+    struct Tracked
+    {
+        static inline int copy_count = 0;
+        static inline int move_count = 0;
+
+        int value;
+
+        Tracked(int value)
+            : value{value}
+        {
+        }
+
+        Tracked(const Tracked& other)
+            : value{other.value}
+        {
+            ++copy_count;
+        }
+
+        Tracked(Tracked&& other) noexcept
+            : value{other.value}
+        {
+            ++move_count;
+        }
+
+        static void reset()
+        {
+            copy_count = move_count = 0;
+        }
+    };
+} // namespace AllocationCounting
+
+// global allocation functions replaced for the whole test binary - only counting is added
+// (not inlined - GCC would report free() of memory returned by operator new)
+[[gnu::noinline]] void* operator new(std::size_t size)
+{
+    ++AllocationCounting::allocation_count;
+
+    if (void* ptr = std::malloc(size == 0 ? 1 : size))
+        return ptr;
+
+    throw std::bad_alloc{};
+}
+
+[[gnu::noinline]] void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+[[gnu::noinline]] void operator delete(void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
 TEST_CASE("make_vector - create vector from a list of arguments")
 {
-    // SECTION("ints")
-    // {
-    //     std::vector<int> v = vt::make_vector(1, 2, 3);
+    using AllocationCounting::Tracked;
 
-    //     REQUIRE(v == vector{1, 2, 3});
-    // }
+    SECTION("ints")
+    {
+        std::vector<int> v = vt::make_vector(1, 2, 3);
 
-    // SECTION("unique_ptrs")
-    // {
-    //     auto ptrs = vt::make_vector(make_unique<int>(5), make_unique<int>(6));
+        REQUIRE(v == vector{1, 2, 3});
+    }
 
-    //     REQUIRE(ptrs.size() == 2);
-    //     REQUIRE(*ptrs[0] == 5);
-    //     REQUIRE(*ptrs[1] == 6);
-    // }
+    SECTION("common type")
+    {
+        auto v = vt::make_vector(1, 2.5, 3L);
+
+        static_assert(std::is_same_v<decltype(v), std::vector<double>>);
+        REQUIRE(v == vector{1.0, 2.5, 3.0});
+    }
+
+    SECTION("unique_ptrs")
+    {
+        auto ptrs = vt::make_vector(make_unique<int>(5), make_unique<int>(6));
+
+        REQUIRE(ptrs.size() == 2);
+        REQUIRE(*ptrs[0] == 5);
+        REQUIRE(*ptrs[1] == 6);
+    }
+
+    SECTION("one allocation & no copies of rvalues")
+    {
+        Tracked::reset();
+        const std::size_t allocations_before = AllocationCounting::allocation_count;
+
+        auto v = vt::make_vector(Tracked{1}, Tracked{2}, Tracked{3}, Tracked{4});
+
+        REQUIRE(AllocationCounting::allocation_count - allocations_before == 1);
+        REQUIRE(Tracked::copy_count == 0);
+        REQUIRE(Tracked::move_count == 4);
+        REQUIRE(v.capacity() == 4);
+        REQUIRE(v[3].value == 4);
+    }
+
+    SECTION("lvalues are copied once")
+    {
+        Tracked first{1}, second{2};
+        Tracked::reset();
+
+        auto v = vt::make_vector(first, std::move(second));
+
+        REQUIRE(Tracked::copy_count == 1);
+        REQUIRE(Tracked::move_count == 1);
+    }
+
+    SECTION("initializer_list copies every item")
+    {
+        Tracked::reset();
+
+        std::vector<Tracked> v{Tracked{1}, Tracked{2}, Tracked{3}, Tracked{4}};
+
+        REQUIRE(Tracked::copy_count == 4);
+    }
+}
+
+TEST_CASE("make_static_vector & make_array - no heap")
+{
+    using AllocationCounting::Tracked;
+
+    SECTION("StaticVector")
+    {
+        Tracked::reset();
+        const std::size_t allocations_before = AllocationCounting::allocation_count;
+
+        auto v = vt::make_static_vector(Tracked{1}, Tracked{2}, Tracked{3});
+
+        static_assert(decltype(v)::capacity() == 3);
+        REQUIRE(AllocationCounting::allocation_count == allocations_before);
+        REQUIRE(Tracked::copy_count == 0);
+        REQUIRE(v.size() == 3);
+        REQUIRE(v[2].value == 3);
+
+        auto ptrs = vt::make_static_vector(make_unique<int>(5), make_unique<int>(6));
+        REQUIRE(*ptrs[1] == 6);
+    }
+
+    SECTION("std::array")
+    {
+        Tracked::reset();
+        const std::size_t allocations_before = AllocationCounting::allocation_count;
+
+        auto items = vt::make_array(Tracked{1}, Tracked{2}, Tracked{3});
+
+        REQUIRE(AllocationCounting::allocation_count == allocations_before);
+        REQUIRE(Tracked::copy_count == 0);
+        REQUIRE(Tracked::move_count == 3);
+        REQUIRE(items[0].value == 1);
+    }
+
+    SECTION("std::array - common type")
+    {
+        auto items = vt::make_array(1, 2.5, 3L);
+
+        static_assert(std::is_same_v<decltype(items), std::array<double, 3>>);
+        REQUIRE(items == std::array{1.0, 2.5, 3.0});
+    }
+
+    SECTION("compile time")
+    {
+        constexpr auto items = vt::make_array(1, 2, 3);
+        static_assert(std::is_same_v<decltype(items), const std::array<int, 3>>);
+        static_assert(items[2] == 3);
+
+        static_assert(vt::make_static_vector(1, 2.5).size() == 2);
+        static_assert(vt::make_vector(1, 2, 3).size() == 3);
+    }
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
@@ -117,8 +649,7 @@ namespace vt
         seed ^= hash<T>{}(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
     }
 
-    // TODO - implement combined_hash function that calculates combined hash value for a given number of arguments
-
+    // combined_hash - see combined_hash.hpp
 } // namespace vt
 
 TEST_CASE("combined_hash - write a function that calculates combined hash value for a given number of arguments")
@@ -132,4 +663,198 @@ TEST_CASE("combined_hash - write a function that calculates combined hash value
     //     CHECK(combined_hash(1, 3.14, "string"s) == 10365827363824479057U);
     //     CHECK(combined_hash(123L, "abc"sv, 234, 3.14f) == 162170636579575197U);
     // #endif
-}
\ No newline at end of file
+}
+
+TEST_CASE("combined_hash - 64-bit", "[combined_hash]")
+{
+    using namespace std::literals;
+
+    SECTION("the same arguments - the same hash")
+    {
+        REQUIRE(vt::combined_hash(1, 3.14, "string"s) == vt::combined_hash(1, 3.14, "string"s));
+        REQUIRE(vt::combined_hash("abc"s) == vt::combined_hash("abc"sv));
+        REQUIRE(vt::combined_hash("abc"s) == vt::combined_hash("abc"));
+        REQUIRE(vt::combined_hash(0.0) == vt::combined_hash(-0.0));
+    }
+
+    SECTION("strings are hashed with wyhash - reference test vectors (message i hashed with seed i)")
+    {
+        const std::pair<std::string_view, std::uint64_t> test_vectors[] = {
+            {""sv, 0x0409638ee2bde459ull},
+            {"a"sv, 0xa8412d091b5fe0a9ull},
+            {"abc"sv, 0x32dd92e4b2915153ull},
+            {"message digest"sv, 0x8619124089a3a16bull},
+            {"abcdefghijklmnopqrstuvwxyz"sv, 0x7a43afb61d7f5f40ull},
+            {"ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789"sv, 0xff42329b90e50d58ull},
+            {"12345678901234567890123456789012345678901234567890123456789012345678901234567890"sv, 0xc39cab13b115aad3ull},
+        };
+
+        for (std::uint64_t seed = 0; const auto& [message, expected] : test_vectors)
+        {
+            INFO("message: " << message);
+            REQUIRE(vt::Hashing::hash_bytes(message.data(), message.size(), seed++) == expected);
+        }
+    }
+
+    SECTION("order & number of arguments matter")
+    {
+        REQUIRE(vt::combined_hash(1, 2) != vt::combined_hash(2, 1));
+        REQUIRE(vt::combined_hash(1) != vt::combined_hash(1, 0));
+        REQUIRE(vt::combined_hash("ab"s, "c"s) != vt::combined_hash("a"s, "bc"s));
+        REQUIRE(vt::combined_hash() != vt::combined_hash(0));
+    }
+
+    SECTION("no collisions for 2^20 composite keys")
+    {
+        std::unordered_set<std::uint64_t> hashes;
+
+        for (int i = 0; i < 1024; ++i)
+            for (int j = 0; j < 1024; ++j)
+                hashes.insert(vt::combined_hash(i, j));
+
+        REQUIRE(hashes.size() == 1024 * 1024);
+    }
+
+    SECTION("low bits are uniform - buckets of a hash table with 2^12 buckets")
+    {
+        constexpr size_t bucket_count = 4096;
+        constexpr size_t key_count = 64 * bucket_count;
+        std::vector<size_t> buckets(bucket_count);
+
+        for (size_t i = 0; i < key_count; ++i)
+            ++buckets[vt::combined_hash("user-"s + std::to_string(i / 64), static_cast<int>(i % 64)) % bucket_count];
+
+        // chi-square with 4095 degrees of freedom - mean 4095, standard deviation ~90
+        double chi_square = 0.0;
+        for (size_t load : buckets)
+            chi_square += (load - 64.0) * (load - 64.0) / 64.0;
+
+        INFO("chi-square: " << chi_square);
+        REQUIRE(chi_square < 4095 + 5 * 90);
+    }
+
+    SECTION("avalanche - flipping any input bit flips every output bit with probability ~1/2")
+    {
+        constexpr int samples = 4000;
+        std::mt19937_64 random{42};
+        std::vector<std::array<int, 64>> flips(128); // [input bit][output bit]
+
+        for (int s = 0; s < samples; ++s)
+        {
+            const std::uint64_t a = random(), b = random();
+            const std::uint64_t hash = vt::combined_hash(a, b);
+
+            for (int bit = 0; bit < 128; ++bit)
+            {
+                const std::uint64_t flipped = bit < 64 ? vt::combined_hash(a ^ (1ull << bit), b) : vt::combined_hash(a, b ^ (1ull << (bit - 64)));
+                const std::uint64_t difference = hash ^ flipped;
+
+                for (int out = 0; out < 64; ++out)
+                    flips[bit][out] += (difference >> out) & 1;
+            }
+        }
+
+        double worst_bias = 0.0;
+        for (const auto& input_bit : flips)
+            for (int count : input_bit)
+                worst_bias = std::max(worst_bias, std::abs(count / double(samples) - 0.5));
+
+        INFO("worst bias: " << worst_bias);
+        REQUIRE(worst_bias < 0.05); // ~6 standard deviations for 4000 samples
+    }
+}
+
+TEST_CASE("hash_batch", "[combined_hash]")
+{
+    using namespace std::literals;
+
+    std::vector<std::tuple<int, std::string, double>> keys;
+    for (int i = 0; i < 1003; ++i) // not a multiple of the number of lanes
+        keys.emplace_back(i, "key-" + std::to_string(i), i * 0.5);
+
+    std::vector<std::uint64_t> hashes(keys.size());
+    vt::hash_batch(keys, hashes);
+
+    for (size_t i = 0; i < keys.size(); ++i)
+        REQUIRE(hashes[i] == std::apply([](const auto&... args) { return vt::combined_hash(args...); }, keys[i]));
+
+    SECTION("pairs & arrays")
+    {
+        std::vector<std::pair<int, int>> pairs = {{1, 2}, {3, 4}, {5, 6}, {7, 8}, {9, 10}};
+        std::vector<std::uint64_t> pair_hashes(pairs.size());
+        vt::hash_batch(std::span{pairs}, pair_hashes);
+
+        REQUIRE(pair_hashes[4] == vt::combined_hash(9, 10));
+
+        std::array<std::array<long, 3>, 4> arrays{{{1, 2, 3}, {4, 5, 6}, {7, 8, 9}, {10, 11, 12}}};
+        std::vector<std::uint64_t> array_hashes(arrays.size());
+        vt::hash_batch(arrays, array_hashes);
+
+        REQUIRE(array_hashes[1] == vt::combined_hash(4L, 5L, 6L));
+    }
+}
+
+namespace Legacy
+{
+    // fold of vt::hash_combine - 32-bit seed
+    template <typename... Ts>
+    std::uint32_t combined_hash(const Ts&... args)
+    {
+        std::uint32_t seed = 0;
+        (vt::hash_combine(seed, args), ...);
+        return seed;
+    }
+} // namespace Legacy
+
+TEST_CASE("combined_hash - throughput", "[.][benchmark][combined_hash]")
+{
+    constexpr size_t count = 1'000'000;
+
+    std::vector<std::tuple<int, int, long>> numeric_keys;
+    std::vector<std::tuple<std::string, int>> text_keys;
+    for (size_t i = 0; i < count; ++i)
+    {
+        numeric_keys.emplace_back(static_cast<int>(i), static_cast<int>(i % 1000), static_cast<long>(i * 7));
+        text_keys.emplace_back("customer-" + std::to_string(i), static_cast<int>(i % 100));
+    }
+
+    std::vector<std::uint64_t> hashes(count);
+
+    auto fold_each = [&hashes](const auto& keys, auto hash) {
+        for (size_t i = 0; i < keys.size(); ++i)
+            hashes[i] = std::apply(hash, keys[i]);
+        return hashes.back();
+    };
+
+    BENCHMARK("tuple<int, int, long> - hash_combine fold (32-bit)")
+    {
+        return fold_each(numeric_keys, [](const auto&... args) { return Legacy::combined_hash(args...); });
+    };
+
+    BENCHMARK("tuple<int, int, long> - combined_hash")
+    {
+        return fold_each(numeric_keys, [](const auto&... args) { return vt::combined_hash(args...); });
+    };
+
+    BENCHMARK("tuple<int, int, long> - hash_batch")
+    {
+        vt::hash_batch(numeric_keys, hashes);
+        return hashes.back();
+    };
+
+    BENCHMARK("tuple<string, int> - hash_combine fold (32-bit)")
+    {
+        return fold_each(text_keys, [](const auto&... args) { return Legacy::combined_hash(args...); });
+    };
+
+    BENCHMARK("tuple<string, int> - combined_hash")
+    {
+        return fold_each(text_keys, [](const auto&... args) { return vt::combined_hash(args...); });
+    };
+
+    BENCHMARK("tuple<string, int> - hash_batch")
+    {
+        vt::hash_batch(text_keys, hashes);
+        return hashes.back();
+    };
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstddef>
+
+// NTTP
+template <typename T, size_t N>
+struct Array
+{
+    T items[N];
+
+    using iterator = T*;
+    using const_iterator = const T*;
+    using reference = T&;
+    using const_reference = const T&;
+
+    constexpr size_t size() const
+    {
+        return N;
+    }
+
+    constexpr iterator begin() 
+    {
+        return items;
+    }
+
+    constexpr iterator end()
+    {
+        return items + N;
+    }
+
+    constexpr const_iterator begin() const
+    {
+        return items;
+    }
+
+    constexpr const_iterator end() const
+    {
+        return items + N;
+    }
+
+    constexpr reference operator[](size_t index)
+    {
+        return items[index];
+    }
+
+    constexpr const_reference operator[](size_t index) const
+    {
+        return items[index];
+    }
+};
@@ -1,65 +1,89 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_test_macros.hpp>
 #include <iostream>
 #include <string>
 #include <vector>
 
+#include "array.hpp"
+#include "soa_vector.hpp"
+#include "static_vector.hpp"
+
 using namespace std::literals;
 
-// NTTP
-template <typename T, size_t N>
-struct Array
+TEST_CASE("class templates")
 {
-    T items[N];
+    Array<int, 10> arr1 = {};
 
-    using iterator = T*;
-    using const_iterator = const T*;
-    using reference = T&;
-    using const_reference = const T&;
+    static_assert(arr1.size() == 10);
 
-    constexpr size_t size() const
-    {
-        return N;
-    }
+    for(auto& item : arr1)
+        item = 0;
+}
 
-    constexpr iterator begin() 
-    {
-        return items;
-    }
+struct Tracked
+{
+    int value;
 
-    constexpr iterator end()
-    {
-        return items + N;
-    }
+    constexpr Tracked(int v)
+        : value{v}
+    { }
 
-    constexpr const_iterator begin() const
-    {
-        return items;
-    }
+    constexpr Tracked(const Tracked& other)
+        : value{other.value}
+    { }
 
-    constexpr const_iterator end() const
-    {
-        return items + N;
-    }
+    constexpr ~Tracked() { }
+};
+
+constexpr int sum_of_pushed(int count)
+{
+    StaticVector<Tracked, 8> vec;
+
+    for (int i = 1; i <= count; ++i)
+        vec.push_back(Tracked{i});
 
-    constexpr reference operator[](size_t index)
+    vec.pop_back();
+
+    int sum = 0;
+    for (const auto& item : vec)
+        sum += item.value;
+
+    return sum;
+}
+
+static_assert(sum_of_pushed(4) == 6);
+static_assert(StaticVector<int, 3>{1, 2, 3}.back() == 3);
+
+TEST_CASE("StaticVector")
+{
+    SECTION("push_back & pop_back")
     {
-        return items[index];
+        StaticVector<std::string, 4> vec = {"one", "two"};
+        vec.push_back("three");
+
+        REQUIRE(vec.size() == 3);
+        REQUIRE(vec.back() == "three");
+
+        vec.pop_back();
+
+        REQUIRE(vec == StaticVector<std::string, 4>{"one", "two"});
     }
 
-    constexpr const_reference operator[](size_t index) const
+    SECTION("overflow - throw")
     {
-        return items[index];
-    }
-};
+        StaticVector<int, 2> vec = {1, 2};
 
-TEST_CASE("class templates")
-{
-    Array<int, 10> arr1 = {};
+        static_assert(std::is_void_v<decltype(vec.push_back(3))>); // nothing to report - a failure throws
+        REQUIRE_THROWS_AS(vec.push_back(3), std::length_error);
+    }
 
-    static_assert(arr1.size() == 10);
+    SECTION("overflow - report failure")
+    {
+        StaticVector<int, 2, OverflowPolicy::ReportFailure> vec = {1, 2};
 
-    for(auto& item : arr1)
-        item = 0;
+        REQUIRE_FALSE(vec.push_back(3));
+        REQUIRE(vec.size() == 2);
+    }
 }
 
 template <double Factor, typename T>
@@ -98,4 +122,121 @@ TEST_CASE("C++20")
     REQUIRE(scale_by<Coefficients{1, 2}>(3) == 5);
     REQUIRE(scale_with_pair<std::pair{1, 10}>(2) == 12);
     REQUIRE(scale_by_func<[](int x) { return 42 * x; }>(2) == 84);
-}
\ No newline at end of file
+}
+
+struct Person
+{
+    std::string name;
+    int age;
+};
+
+// field names -> column indexes
+namespace PersonField
+{
+    constexpr size_t name = 0;
+    constexpr size_t age = 1;
+} // namespace PersonField
+
+static_assert(Aggregates::field_count<Coefficients> == 2);
+static_assert(Aggregates::field_count<Person> == 2);
+static_assert(std::is_same_v<SoAVector<Person>::field_type<PersonField::age>, int>);
+
+TEST_CASE("SoAVector")
+{
+    SECTION("fields are stored in columns")
+    {
+        SoAVector<Coefficients> coefficients = {{1, 2}, {3, 4}, {5, 6}};
+
+        REQUIRE(coefficients.size() == 3);
+        REQUIRE(std::vector<int>(coefficients.column<0>().begin(), coefficients.column<0>().end()) == std::vector{1, 3, 5});
+        REQUIRE(std::vector<int>(coefficients.column<1>().begin(), coefficients.column<1>().end()) == std::vector{2, 4, 6});
+    }
+
+    SoAVector<Person> people;
+    people.push_back(Person{"Jan", 42});
+    people.push_back(Person{"Anna", 33});
+
+    SECTION("proxy reference gives access to fields by index")
+    {
+        auto [person_name, person_age] = people[1];
+        REQUIRE(person_name == "Anna");
+
+        person_age = 34;
+        REQUIRE(std::get<PersonField::age>(people[1]) == 34);
+    }
+
+    SECTION("item is assembled from columns")
+    {
+        Person p = people.item(0);
+
+        REQUIRE(p.name == "Jan");
+        REQUIRE(p.age == 42);
+    }
+
+    SECTION("iteration")
+    {
+        std::string names;
+        for (const auto& [person_name, person_age] : people)
+            names += person_name;
+
+        REQUIRE(names == "JanAnna");
+    }
+
+    SECTION("pop_back & clear")
+    {
+        people.pop_back();
+        REQUIRE(people.size() == 1);
+
+        people.clear();
+        REQUIRE(people.empty());
+    }
+}
+
+TEST_CASE("SoAVector vs std::vector", "[.][benchmark]")
+{
+    constexpr int count = 100'000;
+
+    std::vector<Person> aos;
+    SoAVector<Person> soa;
+    aos.reserve(count);
+    soa.reserve(count);
+
+    for (int i = 0; i < count; ++i)
+    {
+        Person p{"Person-"s + std::to_string(i), i % 100};
+        aos.push_back(p);
+        soa.push_back(std::move(p));
+    }
+
+    BENCHMARK("sum of ages - std::vector<Person>")
+    {
+        long sum = 0;
+        for (const auto& p : aos)
+            sum += p.age;
+        return sum;
+    };
+
+    BENCHMARK("sum of ages - SoAVector<Person>")
+    {
+        long sum = 0;
+        for (int a : soa.column<PersonField::age>())
+            sum += a;
+        return sum;
+    };
+
+    BENCHMARK("full records - std::vector<Person>")
+    {
+        size_t result = 0;
+        for (const auto& p : aos)
+            result += p.name.size() * p.age;
+        return result;
+    };
+
+    BENCHMARK("full records - SoAVector<Person>")
+    {
+        size_t result = 0;
+        for (const auto& [person_name, person_age] : soa)
+            result += person_name.size() * person_age;
+        return result;
+    };
+}
@@ -0,0 +1,308 @@
+#pragma once
+
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Compile-time decomposition of aggregates into their fields
+namespace Aggregates
+{
+    // converts to any field type - used only in unevaluated contexts
+    struct AnyField
+    {
+        template <typename T>
+        operator T() const;
+    };
+
+    template <typename T, typename... TArgs>
+    concept BraceConstructible = requires(TArgs... args) { T{args...}; };
+
+    template <typename T, typename... TFields>
+    constexpr size_t count_fields()
+    {
+        if constexpr (BraceConstructible<T, TFields..., AnyField>)
+            return count_fields<T, TFields..., AnyField>();
+        else
+            return sizeof...(TFields);
+    }
+
+    template <typename T>
+    constexpr size_t field_count = count_fields<T>();
+
+    constexpr size_t max_field_count = 8;
+
+    // tuple of references to the fields of an aggregate
+    template <typename T>
+    constexpr auto tie_fields(T& item)
+    {
+        constexpr size_t count = field_count<std::remove_cv_t<T>>;
+        static_assert(count > 0 && count <= max_field_count, "Aggregate must have from 1 to 8 fields");
+
+        if constexpr (count == 1)
+        {
+            auto& [f1] = item;
+            return std::tie(f1);
+        }
+        else if constexpr (count == 2)
+        {
+            auto& [f1, f2] = item;
+            return std::tie(f1, f2);
+        }
+        else if constexpr (count == 3)
+        {
+            auto& [f1, f2, f3] = item;
+            return std::tie(f1, f2, f3);
+        }
+        else if constexpr (count == 4)
+        {
+            auto& [f1, f2, f3, f4] = item;
+            return std::tie(f1, f2, f3, f4);
+        }
+        else if constexpr (count == 5)
+        {
+            auto& [f1, f2, f3, f4, f5] = item;
+            return std::tie(f1, f2, f3, f4, f5);
+        }
+        else if constexpr (count == 6)
+        {
+            auto& [f1, f2, f3, f4, f5, f6] = item;
+            return std::tie(f1, f2, f3, f4, f5, f6);
+        }
+        else if constexpr (count == 7)
+        {
+            auto& [f1, f2, f3, f4, f5, f6, f7] = item;
+            return std::tie(f1, f2, f3, f4, f5, f6, f7);
+        }
+        else
+        {
+            auto& [f1, f2, f3, f4, f5, f6, f7, f8] = item;
+            return std::tie(f1, f2, f3, f4, f5, f6, f7, f8);
+        }
+    }
+
+    template <typename T>
+    using FieldRefs = decltype(tie_fields(std::declval<T&>()));
+
+    template <size_t I, typename T>
+    using FieldType = std::remove_reference_t<std::tuple_element_t<I, FieldRefs<T>>>;
+
+    template <typename TFieldRefs>
+    struct Columns;
+
+    template <typename... TFields>
+    struct Columns<std::tuple<TFields&...>>
+    {
+        using type = std::tuple<std::vector<TFields>...>;
+        using reference = std::tuple<TFields&...>;
+        using const_reference = std::tuple<const TFields&...>;
+    };
+} // namespace Aggregates
+
+// Vector of aggregates stored as a structure of arrays - every field lives in its own contiguous column
+// - fields are accessed by index: column<I>(), std::get<I>(soa[i])
+template <typename T>
+    requires std::is_aggregate_v<T>
+class SoAVector
+{
+    using Columns = Aggregates::Columns<Aggregates::FieldRefs<T>>;
+
+    typename Columns::type columns;
+
+    template <typename TSelf, size_t... Is>
+    static auto tie_row(TSelf& self, size_t index, std::index_sequence<Is...>)
+    {
+        return std::tie(std::get<Is>(self.columns)[index]...);
+    }
+
+    template <typename TItem, size_t... Is>
+    void push_fields(TItem&& item, std::index_sequence<Is...>)
+    {
+        const size_t old_size = size();
+        auto fields = Aggregates::tie_fields(item);
+
+        try
+        {
+            if constexpr (std::is_lvalue_reference_v<TItem>)
+                (std::get<Is>(columns).push_back(std::get<Is>(fields)), ...);
+            else
+                (std::get<Is>(columns).push_back(std::move(std::get<Is>(fields))), ...);
+        }
+        catch (...)
+        {
+            // keeps columns of equal length
+            for_each_column([old_size](auto& column) { column.erase(column.begin() + old_size, column.end()); });
+            throw;
+        }
+    }
+
+    template <size_t... Is>
+    T make_item(size_t index, std::index_sequence<Is...>) const
+    {
+        return T{std::get<Is>(columns)[index]...};
+    }
+
+    template <typename TFunction>
+    void for_each_column(TFunction f)
+    {
+        std::apply([&f](auto&... column) { (f(column), ...); }, columns);
+    }
+
+    static constexpr auto field_indexes = std::make_index_sequence<Aggregates::field_count<T>>{};
+
+    template <bool IsConst>
+    class Iterator
+    {
+        using Owner = std::conditional_t<IsConst, const SoAVector, SoAVector>;
+
+        Owner* owner = nullptr;
+        size_t index = 0;
+
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using reference = std::conditional_t<IsConst, typename Columns::const_reference, typename Columns::reference>;
+
+        Iterator() = default;
+
+        Iterator(Owner* soa, size_t position)
+            : owner{soa}
+            , index{position}
+        {
+        }
+
+        reference operator*() const
+        {
+            return (*owner)[index];
+        }
+
+        Iterator& operator++()
+        {
+            ++index;
+            return *this;
+        }
+
+        Iterator operator++(int)
+        {
+            Iterator temp = *this;
+            ++index;
+            return temp;
+        }
+
+        bool operator==(const Iterator& other) const
+        {
+            return index == other.index;
+        }
+    };
+
+public:
+    using value_type = T;
+    using size_type = size_t;
+    using reference = typename Columns::reference;
+    using const_reference = typename Columns::const_reference;
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    template <size_t I>
+    using field_type = Aggregates::FieldType<I, T>;
+
+    static constexpr size_t field_count = Aggregates::field_count<T>;
+
+    SoAVector() = default;
+
+    SoAVector(std::initializer_list<T> il)
+    {
+        reserve(il.size());
+        for (const auto& item : il)
+            push_back(item);
+    }
+
+    size_t size() const
+    {
+        return std::get<0>(columns).size();
+    }
+
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+    void reserve(size_t capacity)
+    {
+        for_each_column([capacity](auto& column) { column.reserve(capacity); });
+    }
+
+    void clear()
+    {
+        for_each_column([](auto& column) { column.clear(); });
+    }
+
+    void push_back(const T& item)
+    {
+        push_fields(item, field_indexes);
+    }
+
+    void push_back(T&& item)
+    {
+        push_fields(std::move(item), field_indexes);
+    }
+
+    void pop_back()
+    {
+        for_each_column([](auto& column) { column.pop_back(); });
+    }
+
+    // tuple of references to the fields of an item
+    reference operator[](size_t index)
+    {
+        return tie_row(*this, index, field_indexes);
+    }
+
+    const_reference operator[](size_t index) const
+    {
+        return tie_row(*this, index, field_indexes);
+    }
+
+    // copy of an item assembled from the columns
+    T item(size_t index) const
+    {
+        return make_item(index, field_indexes);
+    }
+
+    template <size_t I>
+    std::span<field_type<I>> column()
+    {
+        return std::get<I>(columns);
+    }
+
+    template <size_t I>
+    std::span<const field_type<I>> column() const
+    {
+        return std::get<I>(columns);
+    }
+
+    iterator begin()
+    {
+        return iterator{this, 0};
+    }
+
+    iterator end()
+    {
+        return iterator{this, size()};
+    }
+
+    const_iterator begin() const
+    {
+        return const_iterator{this, 0};
+    }
+
+    const_iterator end() const
+    {
+        return const_iterator{this, size()};
+    }
+};
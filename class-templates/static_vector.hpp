@@ -0,0 +1,250 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "array.hpp"
+
+// What StaticVector does when an item is pushed into a full vector
+// (an overflow during constant evaluation is always a compile error)
+namespace OverflowPolicy
+{
+    struct Throw
+    {
+        [[noreturn]] static void on_overflow()
+        {
+            throw std::length_error("StaticVector capacity exceeded");
+        }
+    };
+
+    struct Assert
+    {
+        static bool on_overflow()
+        {
+            assert(false && "StaticVector capacity exceeded");
+            return false;
+        }
+    };
+
+    struct ReportFailure
+    {
+        static constexpr bool on_overflow() noexcept
+        {
+            return false;
+        }
+    };
+} // namespace OverflowPolicy
+
+// Fixed-capacity vector - items live in uninitialized Array<T, N> storage inside the object (no allocations)
+template <typename T, size_t N, typename TOverflowPolicy = OverflowPolicy::Throw>
+class StaticVector
+{
+    static_assert(N > 0, "Capacity must be greater than zero");
+
+    union Storage
+    {
+        Array<T, N> array;
+
+        constexpr Storage() { }
+        constexpr ~Storage() { }
+    };
+
+    Storage storage;
+    size_t item_count = 0;
+
+    template <typename TIterator>
+    constexpr void construct_from(TIterator first, TIterator last)
+    {
+        for (; first != last; ++first)
+        {
+            std::construct_at(end(), *first);
+            ++item_count;
+        }
+    }
+
+public:
+    using value_type = T;
+    using size_type = size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = T&;
+    using const_reference = const T&;
+    using pointer = T*;
+    using const_pointer = const T*;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    constexpr StaticVector() = default;
+
+    constexpr StaticVector(std::initializer_list<T> il)
+    {
+        for (const auto& item : il)
+            push_back(item);
+    }
+
+    constexpr StaticVector(const StaticVector& other)
+    {
+        construct_from(other.begin(), other.end());
+    }
+
+    constexpr StaticVector(StaticVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+    {
+        construct_from(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+    }
+
+    constexpr StaticVector& operator=(const StaticVector& other)
+    {
+        if (this != &other)
+        {
+            clear();
+            construct_from(other.begin(), other.end());
+        }
+
+        return *this;
+    }
+
+    constexpr StaticVector& operator=(StaticVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+    {
+        if (this != &other)
+        {
+            clear();
+            construct_from(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+        }
+
+        return *this;
+    }
+
+    constexpr ~StaticVector()
+    {
+        clear();
+    }
+
+    static constexpr size_t capacity()
+    {
+        return N;
+    }
+
+    constexpr size_t size() const
+    {
+        return item_count;
+    }
+
+    constexpr bool empty() const
+    {
+        return item_count == 0;
+    }
+
+    constexpr bool full() const
+    {
+        return item_count == N;
+    }
+
+    // void if the overflow policy throws, otherwise bool - false if the vector is full
+    using push_result = decltype(TOverflowPolicy::on_overflow());
+
+    template <typename... TArgs>
+    constexpr push_result emplace_back(TArgs&&... args)
+    {
+        if (full())
+            return TOverflowPolicy::on_overflow();
+
+        std::construct_at(end(), std::forward<TArgs>(args)...);
+        ++item_count;
+
+        if constexpr (!std::is_void_v<push_result>)
+            return true;
+    }
+
+    constexpr push_result push_back(const T& value)
+    {
+        return emplace_back(value);
+    }
+
+    constexpr push_result push_back(T&& value)
+    {
+        return emplace_back(std::move(value));
+    }
+
+    constexpr void pop_back()
+    {
+        --item_count;
+        std::destroy_at(end());
+    }
+
+    constexpr void clear()
+    {
+        std::destroy(begin(), end());
+        item_count = 0;
+    }
+
+    constexpr reference back()
+    {
+        return storage.array[item_count - 1];
+    }
+
+    constexpr const_reference back() const
+    {
+        return storage.array[item_count - 1];
+    }
+
+    constexpr reference front()
+    {
+        return storage.array[0];
+    }
+
+    constexpr const_reference front() const
+    {
+        return storage.array[0];
+    }
+
+    constexpr reference operator[](size_t index)
+    {
+        return storage.array[index];
+    }
+
+    constexpr const_reference operator[](size_t index) const
+    {
+        return storage.array[index];
+    }
+
+    constexpr T* data()
+    {
+        return storage.array.items;
+    }
+
+    constexpr const T* data() const
+    {
+        return storage.array.items;
+    }
+
+    constexpr iterator begin()
+    {
+        return storage.array.items;
+    }
+
+    constexpr iterator end()
+    {
+        return storage.array.items + item_count;
+    }
+
+    constexpr const_iterator begin() const
+    {
+        return storage.array.items;
+    }
+
+    constexpr const_iterator end() const
+    {
+        return storage.array.items + item_count;
+    }
+
+    friend constexpr bool operator==(const StaticVector& lhs, const StaticVector& rhs)
+    {
+        return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    }
+};
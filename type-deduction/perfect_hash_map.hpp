@@ -0,0 +1,194 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+
+namespace PerfectHashing
+{
+    // 64x64 -> 128 bit multiplication folded to 64 bits
+    constexpr std::uint64_t mix(std::uint64_t a, std::uint64_t b)
+    {
+#if defined(__SIZEOF_INT128__)
+        const unsigned __int128 product = static_cast<unsigned __int128>(a) * b;
+        return static_cast<std::uint64_t>(product) ^ static_cast<std::uint64_t>(product >> 64);
+#else
+        const std::uint64_t a_low = a & 0xffffffff, a_high = a >> 32;
+        const std::uint64_t b_low = b & 0xffffffff, b_high = b >> 32;
+        const std::uint64_t low_low = a_low * b_low, low_high = a_low * b_high, high_low = a_high * b_low, high_high = a_high * b_high;
+        const std::uint64_t middle = (low_low >> 32) + (low_high & 0xffffffff) + (high_low & 0xffffffff);
+        return ((middle << 32) | (low_low & 0xffffffff)) ^ (high_high + (low_high >> 32) + (high_low >> 32) + (middle >> 32));
+#endif
+    }
+
+    // little-endian read of up to 8 chars - compilers merge it into a single load
+    constexpr std::uint64_t read(const char* p, std::size_t count)
+    {
+        std::uint64_t value = 0;
+        for (std::size_t i = 0; i < count; ++i)
+            value |= std::uint64_t{static_cast<unsigned char>(p[i])} << (8 * i);
+        return value;
+    }
+
+    // string hash usable both at compile time & at runtime
+    constexpr std::uint64_t hash(std::string_view text, std::uint64_t seed)
+    {
+        std::uint64_t h = seed ^ (text.size() * 0x9e3779b97f4a7c15ull);
+        const char* p = text.data();
+        std::size_t left = text.size();
+
+        for (; left > 8; left -= 8, p += 8)
+            h = mix(h ^ read(p, 8), 0xe7037ed1a0b428dbull);
+
+        // 1-8 chars left - fixed-size reads (overlapping for 5-7 chars) instead of a loop over chars
+        std::uint64_t tail = 0;
+        if (left >= 4)
+            tail = read(p, 4) | (read(p + left - 4, 4) << 32);
+        else if (left > 0)
+            tail = read(p, 1) | (read(p + left / 2, 1) << 8) | (read(p + left - 1, 1) << 16);
+
+        h = mix(h ^ tail, 0x8ebc6af09c88c6e3ull);
+        return mix(h, 0x589965cc75374cc3ull);
+    }
+} // namespace PerfectHashing
+
+// Read-only map with string keys built at compile time - no heap, no static initialization at runtime
+// - find: one string hash, one mix & one key comparison (hash & displace: a key's bucket selects
+//   the displacement that moves the key to its own slot)
+// - the table has 2x more slots than keys, so displacements are found quickly during compilation
+template <typename TValue, std::size_t N>
+class PerfectHashMap
+{
+    static constexpr std::size_t table_size = std::bit_ceil(2 * N + 1);
+    static constexpr std::size_t bucket_count = std::bit_ceil(N / 2 + 1);
+
+    std::uint64_t seed = 0;
+    std::array<std::uint64_t, bucket_count> displacements{};
+    std::array<std::string_view, table_size> keys{};
+    std::array<TValue, table_size> values{};
+    std::array<bool, table_size> occupied{};
+
+    static constexpr std::size_t slot_of(std::uint64_t hash, std::uint64_t displacement)
+    {
+        return PerfectHashing::mix(hash ^ displacement, 0xa0761d6478bd642full) & (table_size - 1);
+    }
+
+    static constexpr std::size_t bucket_of(std::uint64_t hash)
+    {
+        return (hash >> 32) & (bucket_count - 1);
+    }
+
+    // places the keys of every bucket (the largest buckets first); false if some bucket cannot be placed
+    constexpr bool place(const std::array<std::uint64_t, N>& hashes)
+    {
+        std::array<std::size_t, N> order{};
+        for (std::size_t i = 0; i < N; ++i)
+            order[i] = i;
+
+        std::array<std::size_t, bucket_count> bucket_sizes{};
+        for (std::uint64_t h : hashes)
+            ++bucket_sizes[bucket_of(h)];
+
+        std::ranges::sort(order, [&](std::size_t a, std::size_t b) {
+            const std::size_t bucket_a = bucket_of(hashes[a]), bucket_b = bucket_of(hashes[b]);
+            return bucket_sizes[bucket_a] != bucket_sizes[bucket_b] ? bucket_sizes[bucket_a] > bucket_sizes[bucket_b] : bucket_a < bucket_b;
+        });
+
+        occupied = {};
+
+        for (std::size_t first = 0; first < N;)
+        {
+            const std::size_t bucket = bucket_of(hashes[order[first]]);
+            const std::size_t last = first + bucket_sizes[bucket];
+
+            bool placed = false;
+            for (std::uint64_t displacement = 1; !placed && displacement < 4096; ++displacement)
+            {
+                std::array<std::size_t, N> slots{};
+                placed = true;
+
+                for (std::size_t i = first; placed && i < last; ++i)
+                {
+                    slots[i] = slot_of(hashes[order[i]], displacement);
+                    placed = !occupied[slots[i]] && std::find(slots.begin() + first, slots.begin() + i, slots[i]) == slots.begin() + i;
+                }
+
+                if (placed)
+                {
+                    displacements[bucket] = displacement;
+                    for (std::size_t i = first; i < last; ++i)
+                        occupied[slots[i]] = true;
+                }
+            }
+
+            if (!placed)
+                return false;
+
+            first = last;
+        }
+
+        return true;
+    }
+
+public:
+    consteval explicit PerfectHashMap(const std::pair<std::string_view, TValue> (&entries)[N])
+    {
+        for (std::size_t i = 0; i < N; ++i)
+            for (std::size_t j = i + 1; j < N; ++j)
+                if (entries[i].first == entries[j].first)
+                    throw std::invalid_argument("duplicate key"); // compilation error
+
+        // seeds are tried until every bucket gets a collision-free displacement
+        std::array<std::uint64_t, N> hashes{};
+        do
+        {
+            ++seed;
+            for (std::size_t i = 0; i < N; ++i)
+                hashes[i] = PerfectHashing::hash(entries[i].first, seed);
+        } while (!place(hashes));
+
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            const std::size_t slot = slot_of(hashes[i], displacements[bucket_of(hashes[i])]);
+            keys[slot] = entries[i].first;
+            values[slot] = entries[i].second;
+        }
+    }
+
+    constexpr const TValue* find(std::string_view key) const
+    {
+        const std::uint64_t hash = PerfectHashing::hash(key, seed);
+        const std::size_t slot = slot_of(hash, displacements[bucket_of(hash)]);
+
+        return occupied[slot] && keys[slot] == key ? &values[slot] : nullptr;
+    }
+
+    constexpr bool contains(std::string_view key) const
+    {
+        return find(key) != nullptr;
+    }
+
+    constexpr const TValue& at(std::string_view key) const
+    {
+        if (const TValue* value = find(key))
+            return *value;
+
+        throw std::out_of_range("PerfectHashMap: key not found");
+    }
+
+    constexpr std::size_t size() const
+    {
+        return N;
+    }
+};
+
+template <typename TValue, std::size_t N>
+consteval PerfectHashMap<TValue, N> make_perfect_hash_map(const std::pair<std::string_view, TValue> (&entries)[N])
+{
+    return PerfectHashMap<TValue, N>{entries};
+}
@@ -1,12 +1,15 @@
-#include "catch.hpp"
-
 #include <algorithm>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
 #include <iostream>
 #include <memory>
 #include <numeric>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
+#include "perfect_hash_map.hpp"
+
 using namespace std;
 
 #ifdef _MSC_VER
@@ -211,6 +214,87 @@ TEST_CASE("decltype(auto)")
     decltype(dict) d2;
 }
 
+TEST_CASE("PerfectHashMap - dictionary built at compile time")
+{
+    static constexpr auto dict = make_perfect_hash_map<int>({{"one", 1}, {"two", 2}});
+
+    static_assert(dict.size() == 2);
+    static_assert(dict.at("two") == 2);
+    static_assert(!dict.contains("three"));
+
+    auto ad = dict; // copy - the same table, no heap
+    REQUIRE(*ad.find("one") == 1);
+    REQUIRE(ad.find("") == nullptr);
+
+    decltype(auto) value = dict.at("one"); // const int&
+    static_assert(std::is_same_v<decltype(value), const int&>);
+    REQUIRE(&value == dict.find("one"));
+
+    REQUIRE_THROWS_AS(dict.at("zero"), std::out_of_range);
+}
+
+namespace
+{
+    constexpr std::pair<std::string_view, int> number_words[] = {{"zero", 0}, {"one", 1}, {"two", 2}, {"three", 3}, {"four", 4},
+        {"five", 5}, {"six", 6}, {"seven", 7}, {"eight", 8}, {"nine", 9}, {"ten", 10}, {"eleven", 11}, {"twelve", 12},
+        {"thirteen", 13}, {"fourteen", 14}, {"fifteen", 15}, {"sixteen", 16}, {"seventeen", 17}, {"eighteen", 18},
+        {"nineteen", 19}, {"twenty", 20}, {"thirty", 30}, {"forty", 40}, {"fifty", 50}, {"sixty", 60}, {"seventy", 70},
+        {"eighty", 80}, {"ninety", 90}, {"hundred", 100}, {"thousand", 1'000}, {"million", 1'000'000},
+        {"a very long key that spans many blocks of the hash", -1}, {"", -2}};
+
+    constinit const auto numbers_map = make_perfect_hash_map(number_words); // no code runs at startup
+} // namespace
+
+TEST_CASE("PerfectHashMap - every key is found, other keys are not")
+{
+    for (const auto& [key, value] : number_words)
+    {
+        REQUIRE(numbers_map.find(key) != nullptr);
+        REQUIRE(*numbers_map.find(key) == value);
+    }
+
+    for (std::string_view missing : {"Zero", "on", "twoo", "hundreds", "a very long key that spans many blocks of the hasH"})
+        REQUIRE_FALSE(numbers_map.contains(missing));
+}
+
+TEST_CASE("PerfectHashMap - lookup latency & startup cost", "[.][benchmark]")
+{
+    std::vector<std::string> queries;
+    for (int i = 0; i < 1000; ++i)
+        queries.push_back(i % 4 == 0 ? "missing-" + std::to_string(i) : std::string{number_words[i % std::size(number_words)].first});
+
+    auto make_unordered_map = [] { return std::unordered_map<std::string, int>(std::begin(number_words), std::end(number_words)); };
+    const auto unordered = make_unordered_map();
+
+    BENCHMARK("std::unordered_map - 1000 lookups")
+    {
+        long sum = 0;
+        for (const auto& query : queries)
+            if (auto it = unordered.find(query); it != unordered.end())
+                sum += it->second;
+        return sum;
+    };
+
+    BENCHMARK("PerfectHashMap - 1000 lookups")
+    {
+        long sum = 0;
+        for (const auto& query : queries)
+            if (const int* value = numbers_map.find(query))
+                sum += *value;
+        return sum;
+    };
+
+    BENCHMARK("std::unordered_map - startup (construction) & first lookup")
+    {
+        return make_unordered_map().at("seven");
+    };
+
+    BENCHMARK("PerfectHashMap - startup (constinit) & first lookup")
+    {
+        return numbers_map.at("seven");
+    };
+}
+
 template <typename TRange>
 decltype(auto) get_nth(TRange& container, size_t nth)
 {